@@ -2,7 +2,9 @@
 
 #include <string>
 #include <fstream>
+#include <curl/curl.h>
 #include <jsoncpp/json/json.h> // Changed from json/json.h to jsoncpp/json/json.h
+#include "get_coordinates/chat_request_builder.hpp"
 
 namespace get_coordinates {
 
@@ -15,8 +17,8 @@ public:
     AICore();
     ~AICore();
     
-    // Main API call method for the LLM (with image)
-    std::string AI_Image_Prompt(const std::string& messages,
+    // Main API call method for the LLM (with image); the request is finished and sent as is
+    std::string AI_Image_Prompt(ChatRequestBuilder& messages,
                                double temperature = 1.0,
                                int max_tokens = 300,
                                double frequency_penalty = 0.0,
@@ -28,7 +30,7 @@ public:
     // Get parsed JSON data from LLM response
     Json::Value get_json_from_llm_response(const std::string& raw_response);
     
-    // Initialize connection to the API
+    // Initialize connection to the API, keeping the handle open for later requests
     void initialize_connection();
 
 private:
@@ -36,6 +38,13 @@ private:
     std::string api_endpoint;
     std::string api_key;
     
+    // Request headers, built once; handles and connections come from HttpClient
+    struct curl_slist* headers = nullptr;
+    bool connection_ready = false;
+    long request_timeout_ms = 60000;
+    
+    void prepare_headers();
+    
     // Send the HTTP request to the API
     std::string send_request(const std::string& payload);
     
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <string>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <condition_variable>
+#include <opencv2/opencv.hpp>
+
+namespace get_coordinates {
+
+class ArtifactSink {
+public:
+    enum class Mode {
+        Off,    // Discard every artifact
+        Async,  // Queue artifacts for a background writer, dropping them when the queue is full
+        Sync    // Write artifacts on the calling thread
+    };
+
+    struct Stats {
+        uint64_t written = 0;
+        uint64_t dropped = 0;
+        uint64_t failed = 0;
+    };
+
+    ArtifactSink(Mode mode = Mode::Async, size_t max_queued = 8);
+    ~ArtifactSink();
+
+    ArtifactSink(const ArtifactSink&) = delete;
+    ArtifactSink& operator=(const ArtifactSink&) = delete;
+
+    /**
+     * Save an image, encoded by file extension
+     * 
+     * In async mode the image is shared with the writer, so the caller must not
+     * modify its pixels afterwards (reassigning the cv::Mat is fine).
+     * 
+     * @param path The output file path
+     * @param image The image to save
+     */
+    void saveImage(const std::string& path, const cv::Mat& image);
+
+    /**
+     * Save a text artifact such as a JSON dump
+     * 
+     * @param path The output file path
+     * @param contents The file contents
+     */
+    void saveText(const std::string& path, std::string contents);
+
+    /**
+     * Block until every queued artifact has been written
+     */
+    void flush();
+
+    Mode mode() const { return sink_mode; }
+    Stats stats() const;
+
+private:
+    struct Artifact {
+        std::string path;
+        cv::Mat image;
+        std::string text;
+        bool is_image = false;
+    };
+
+    Mode sink_mode;
+    size_t max_queued;
+
+    std::mutex queue_mutex;
+    std::condition_variable queue_changed;
+    std::deque<Artifact> queue;
+    bool writing = false;
+    bool stopping = false;
+    std::thread writer;
+
+    std::atomic<uint64_t> written{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> failed{0};
+
+    void submit(Artifact artifact);
+    void write(const Artifact& artifact);
+    void writerLoop();
+};
+
+} // namespace get_coordinates
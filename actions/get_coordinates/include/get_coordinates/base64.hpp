@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace get_coordinates {
+
+/**
+ * Length of the padded base64 encoding of a byte buffer
+ * 
+ * @param length The number of input bytes
+ * @return size_t The number of output characters
+ */
+inline size_t base64EncodedLength(size_t length) {
+    return (length + 2) / 3 * 4;
+}
+
+/**
+ * Encode bytes as padded base64 into a caller-provided buffer
+ * 
+ * Uses AVX2 or SSSE3 when the CPU supports them, and a scalar loop otherwise.
+ * 
+ * @param data The input bytes
+ * @param length The number of input bytes
+ * @param out The output, at least base64EncodedLength(length) characters
+ */
+void base64Encode(const uint8_t* data, size_t length, char* out);
+
+/**
+ * Build a data URL ("data:<mime>;base64,<payload>") with a single allocation
+ * 
+ * @param mime_type The MIME type of the data, e.g. "image/jpeg"
+ * @param data The input bytes
+ * @param length The number of input bytes
+ * @return std::string The data URL
+ */
+std::string base64DataUrl(const std::string& mime_type, const uint8_t* data, size_t length);
+
+/**
+ * Name of the encoder base64Encode dispatches to on this CPU
+ * 
+ * @return const char* "avx2", "ssse3" or "scalar"
+ */
+const char* base64Implementation();
+
+} // namespace get_coordinates
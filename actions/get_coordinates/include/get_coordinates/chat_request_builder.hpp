@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace get_coordinates {
+
+/**
+ * Writes a chat-completions request body in one pass
+ *
+ * Messages are appended as JSON text straight into one buffer, so large
+ * fields such as image data URLs are copied exactly once and never parsed.
+ * Reserve the expected size up front to avoid regrowing the buffer.
+ */
+class ChatRequestBuilder {
+public:
+    /**
+     * @param reserve_bytes The expected body size
+     */
+    explicit ChatRequestBuilder(size_t reserve_bytes = 0);
+
+    /**
+     * Start a message; its content parts follow until endMessage()
+     * 
+     * @param role The message role, e.g. "system", "user" or "assistant"
+     */
+    void beginMessage(const std::string& role);
+
+    /**
+     * Append a text content part to the current message
+     * 
+     * @param text The text
+     */
+    void addText(const std::string& text);
+
+    /**
+     * Append an image content part to the current message
+     * 
+     * @param url The image URL or data URL
+     */
+    void addImageUrl(const std::string& url);
+
+    void endMessage();
+
+    /**
+     * Append the model parameters and close the body
+     * 
+     * @param model The model name
+     * @param temperature The sampling temperature
+     * @param max_tokens The reply token limit
+     * @param frequency_penalty The frequency penalty
+     * @param presence_penalty The presence penalty
+     * @return std::string The request body; the builder is empty afterwards
+     */
+    std::string finish(const std::string& model, double temperature, int max_tokens,
+                       double frequency_penalty, double presence_penalty);
+
+    // Number of bytes written so far
+    size_t size() const {
+        return body.size();
+    }
+
+private:
+    std::string body;
+    bool first_message = true;
+    bool first_part = true;
+
+    void beginPart();
+    void appendString(const std::string& text);
+    void appendNumber(double value);
+};
+
+} // namespace get_coordinates
@@ -5,6 +5,22 @@
 
 using json = nlohmann::json;
 
+// Run the map pipeline, encode the object map and open the LLM client ahead of the first request.
+// Returns false if warming up failed; findCoordinates then falls back to preparing lazily.
+bool warmupCoordinates(
+    const std::string& map_path,
+    const std::string& items_json_path,
+    const std::string& map_yaml_path,
+    const std::string& output_dir,
+    const json& robot_position = json()
+);
+
+// Hit, miss and eviction counters and the hit rate of the LLM decision cache
+json decisionCacheStats();
+
+// Requests answered by the local resolver, the decision cache and the LLM, and the local share
+json requestPathStats();
+
 // Function declaration to be called from get_coordinates.cpp
 json findCoordinates(
     const std::string& map_path,
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <optional>
+#include "get_coordinates/getcoord_map_layers.hpp"
+#include "get_coordinates/getcoord_nonTraversable_generation.hpp"
+
+namespace GetCoordApproachPose {
+    // Ring of standoff poses sampled around an item
+    struct Settings {
+        double min_standoff_m = 0.3;    // Closest ring, measured from the item footprint
+        double max_standoff_m = 1.5;    // Farthest ring tried when the closer ones are blocked
+        double standoff_step_m = 0.1;
+        int samples = 32;               // Poses per ring
+    };
+
+    // Where the robot should stand, facing the item
+    struct Pose {
+        cv::Point pixel{-1, -1};
+        float angle_deg = 0.0f;     // Yaw towards the item centre, 0 at 3 o'clock, counter-clockwise
+        double standoff_m = 0.0;
+        double path_m = -1.0;       // Path distance from the reachability seed, -1 without a field
+    };
+
+    /**
+     * Yaw of a robot at a pixel looking at a point of the map
+     *
+     * @param from The robot pixel
+     * @param target The pixel to look at
+     * @return float The yaw in degrees, 0 at 3 o'clock, counter-clockwise
+     */
+    float facing(const cv::Point& from, const cv::Point2f& target);
+
+    /**
+     * Pick a standoff pose around an item
+     *
+     * Rings around the item box are tried from the closest outwards. On each ring,
+     * samples that leave the map, fall on an item or are not free in the cost layer
+     * (obstacles and their inflation) or not reachable from the seed are rejected;
+     * the first ring with a valid sample wins and on it the sample with the shortest
+     * path from the seed is taken.
+     *
+     * @param layers The map layers, for the item labels and walkability
+     * @param field The reachability field of the request, free space is used when it is empty
+     * @param item_box The item box in map pixels
+     * @param resolution The resolution of the map in meters per pixel
+     * @param settings The rings to sample
+     * @return std::optional<Pose> The pose, empty when every sample is blocked
+     */
+    std::optional<Pose> solve(const GetCoordMapLayers::MapLayers& layers,
+                              const GetCoordNonTraversableGeneration::ReachabilityField& field,
+                              const cv::Rect& item_box,
+                              double resolution,
+                              const Settings& settings = Settings());
+}
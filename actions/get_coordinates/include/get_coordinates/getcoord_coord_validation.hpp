@@ -0,0 +1,77 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "get_coordinates/getcoord_map_layers.hpp"
+#include "get_coordinates/getcoord_nonTraversable_generation.hpp"
+
+namespace GetCoordCoordValidation {
+    // Why a pixel cannot be driven to, or Valid
+    enum class Status {
+        Valid,
+        OutsideMap,
+        Obstacle,
+        Inflation,
+        OnItem,
+        Unreachable
+    };
+
+    std::string toString(Status status);
+
+    /**
+     * Nearest valid cell of every map cell
+     *
+     * A cell is valid when it is free in the cost layer, clear of every item and
+     * connected to the map origin. Only robot-independent layers are used, so the
+     * transform is built once per map state and snapping a pixel is a single array read.
+     */
+    struct SnapField {
+        int rows = 0;
+        int cols = 0;
+        std::vector<int32_t> nearest;   // y * cols + x of the nearest valid cell, -1 when there is none
+
+        bool empty() const {
+            return nearest.empty();
+        }
+    };
+
+    /**
+     * Build the nearest-valid-cell transform
+     *
+     * @param layers The map layers, for the walkability, reachable and label planes
+     * @return SnapField The transform, every entry -1 when no cell is valid
+     */
+    SnapField buildSnapField(const GetCoordMapLayers::MapLayers& layers);
+
+    struct Check {
+        Status status = Status::Valid;
+        cv::Point requested{-1, -1};
+        cv::Point snapped{-1, -1};      // Same as requested when it is valid, (-1, -1) when nothing is valid
+        double moved_m = 0.0;
+    };
+
+    /**
+     * Check a pixel and snap it to the nearest valid cell
+     *
+     * Pixels outside the map are clamped to the border first; the distance moved is
+     * measured from the requested pixel. The snap field's cell is used when the robot
+     * can reach it; otherwise, e.g. when the robot is not connected to the map origin,
+     * the cells within max_snap_m are searched for the nearest one it can reach.
+     *
+     * @param layers The map layers the snap field was built on
+     * @param field The reachability field of the request, free space is used when it is empty
+     * @param snap The nearest-valid-cell transform
+     * @param pixel The pixel to check
+     * @param resolution The resolution of the map in meters per pixel
+     * @param max_snap_m The farthest a pixel is moved by the fallback search
+     * @return Check The status of the pixel and where it snaps to
+     */
+    Check validate(const GetCoordMapLayers::MapLayers& layers,
+                   const GetCoordNonTraversableGeneration::ReachabilityField& field,
+                   const SnapField& snap,
+                   const cv::Point& pixel,
+                   double resolution,
+                   double max_snap_m);
+}
@@ -9,7 +9,42 @@ namespace GetCoordCostmapGeneration {
      * @param map_img The input map image
      * @param resolution The resolution of the map in meters per pixel
      * @param inflation_radius_m The inflation radius in meters
+     * @param tile_size Edge length of the tiles processed in parallel, 0 for the serial path
      * @return cv::Mat The generated cost map
      */
-    cv::Mat process(const cv::Mat& map_img, double resolution, double inflation_radius_m);
-}
\ No newline at end of file
+    cv::Mat process(const cv::Mat& map_img, double resolution, double inflation_radius_m, int tile_size = 0);
+
+    /**
+     * Number of pixels each tile must read around its core for an exact cost map
+     * 
+     * @param resolution The resolution of the map in meters per pixel
+     * @param inflation_radius_m The inflation radius in meters
+     * @return int The halo width in pixels
+     */
+    int haloPixels(double resolution, double inflation_radius_m);
+
+    /**
+     * Recompute the cost map only around an edited region of the map image
+     * 
+     * The result is identical to a full rebuild with process(). The work is
+     * proportional to the edit plus twice the inflation halo.
+     * 
+     * @param cost_map The cost map of the map image before the edit, updated in place
+     * @param map_img The edited map image
+     * @param dirty_rect The region of map_img that changed
+     * @param resolution The resolution of the map in meters per pixel
+     * @param inflation_radius_m The inflation radius in meters
+     * @return cv::Rect The region of cost_map that was rewritten
+     */
+    cv::Rect update(cv::Mat& cost_map, const cv::Mat& map_img, const cv::Rect& dirty_rect,
+                    double resolution, double inflation_radius_m);
+
+    /**
+     * Bounding box of the pixels that differ between two map images
+     * 
+     * @param before The map image before the edit
+     * @param after The map image after the edit
+     * @return cv::Rect The changed region, empty if the images are equal, the whole image if their sizes differ
+     */
+    cv::Rect changedRegion(const cv::Mat& before, const cv::Mat& after);
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace GetCoordDecisionCache {
+    struct Settings {
+        // Decisions kept in memory, least recently used ones are evicted first
+        size_t capacity = 256;
+        // Age after which a decision is no longer returned, 0 or less keeps it forever
+        double ttl_s = 3600.0;
+        // Robot positions in the same square of this edge length share decisions
+        double pose_quantum_m = 0.5;
+        // Directory of the on-disk tier, empty to keep decisions in memory only
+        std::string disk_dir;
+    };
+
+    // Identifies one decision: the normalized description, the map content and the robot's cell
+    struct Key {
+        std::string text;
+        uint64_t map_hash = 0;
+        uint64_t hash = 0;
+    };
+
+    struct Stats {
+        uint64_t hits = 0;          // Served from memory
+        uint64_t disk_hits = 0;     // Served from disk, then kept in memory
+        uint64_t misses = 0;
+        uint64_t stores = 0;
+        uint64_t evictions = 0;
+        uint64_t expired = 0;
+        size_t entries = 0;
+
+        double hitRate() const {
+            uint64_t lookups = hits + disk_hits + misses;
+            return lookups == 0 ? 0.0 : static_cast<double>(hits + disk_hits) / lookups;
+        }
+    };
+
+    /**
+     * Lowercase the description, drop punctuation and collapse whitespace, so that
+     * "Chair next to the fridge." and "chair  next to the fridge" share a decision
+     *
+     * @param description The object description of the request
+     * @return std::string The normalized description
+     */
+    std::string normalizeDescription(const std::string& description);
+
+    /**
+     * LLM decisions keyed by request, with an LRU memory tier and an optional disk tier
+     *
+     * Decisions are the LLM results in object map pixels. The disk tier keeps one
+     * file per decision under a directory per map hash, so it survives restarts and
+     * a changed map or items.json can be dropped in one go.
+     */
+    class DecisionCache {
+    public:
+        explicit DecisionCache(Settings settings = {});
+
+        const Settings& settings() const {
+            return config;
+        }
+
+        /**
+         * Build the key of a request
+         *
+         * @param description The object description of the request
+         * @param map_hash The content hash of the map state the decision is made on
+         * @param robot_valid Whether the robot position is known
+         * @param robot_x The robot's world x coordinate
+         * @param robot_y The robot's world y coordinate
+         * @return Key The key of the request
+         */
+        Key makeKey(const std::string& description, uint64_t map_hash,
+                    bool robot_valid, double robot_x, double robot_y) const;
+
+        /**
+         * Look up a decision, memory first, then disk
+         *
+         * @param key The key of the request
+         * @return std::optional<nlohmann::json> The decision, empty on a miss or when it expired
+         */
+        std::optional<nlohmann::json> lookup(const Key& key);
+
+        /**
+         * Store a decision in memory, and on disk when the disk tier is enabled
+         *
+         * @param key The key of the request
+         * @param decision The LLM result in object map pixels
+         */
+        void store(const Key& key, const nlohmann::json& decision);
+
+        /**
+         * Drop every decision made on a map state, in memory and on disk
+         *
+         * @param map_hash The content hash of the outdated map state
+         */
+        void invalidateMap(uint64_t map_hash);
+
+        // Drop every decision, in memory and on disk
+        void clear();
+
+        Stats stats() const;
+
+        // Counters and hit rate as JSON
+        nlohmann::json describe() const;
+
+    private:
+        using Clock = std::chrono::system_clock;
+
+        struct Entry {
+            std::string text;
+            uint64_t map_hash;
+            Clock::time_point stored_at;
+            nlohmann::json decision;
+        };
+
+        Settings config;
+        mutable std::mutex mutex;
+        // Most recently used first
+        std::list<Entry> entries;
+        std::unordered_map<std::string, std::list<Entry>::iterator> index;
+        Stats counters;
+
+        bool expired(Clock::time_point stored_at) const;
+        void insert(Entry entry);
+        std::string diskPath(const Key& key) const;
+        std::optional<Entry> loadFromDisk(const Key& key);
+        void saveToDisk(const Key& key, const Entry& entry);
+    };
+}
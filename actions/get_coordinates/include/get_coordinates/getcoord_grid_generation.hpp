@@ -9,7 +9,17 @@ namespace GetCoordGridGeneration {
      * @param cost_map The input cost map
      * @param resolution The resolution of the map in meters per pixel
      * @param grid_scale The grid scale in pixels
+     * @param band_rows Rows per band processed in parallel, 0 for the serial path
      * @return cv::Mat The generated grid map with grid lines
      */
-    cv::Mat process(const cv::Mat& cost_map, double resolution, int grid_scale);
-}
\ No newline at end of file
+    cv::Mat process(const cv::Mat& cost_map, double resolution, int grid_scale, int band_rows = 0);
+
+    /**
+     * Draw the grid lines directly onto a BGR map
+     * 
+     * @param grid_map The BGR map to draw on
+     * @param grid_scale The grid scale in pixels
+     * @param band_rows Rows per band processed in parallel, 0 for the serial path
+     */
+    void drawInPlace(cv::Mat& grid_map, int grid_scale, int band_rows = 0);
+}
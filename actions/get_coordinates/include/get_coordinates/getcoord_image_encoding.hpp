@@ -0,0 +1,78 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <nlohmann/json.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace GetCoordImageEncoding {
+    enum class Format {
+        Jpeg,
+        Png,
+        Webp
+    };
+
+    // Encoder configuration; a budget of 0 means unlimited
+    struct Settings {
+        Format format = Format::Jpeg;
+        int quality = 95;            // JPEG/WebP quality to start from, 1-100 (ignored for PNG)
+        int min_quality = 40;        // Quality is lowered in steps down to this before downscaling
+        size_t max_bytes = 0;        // Largest encoded size
+        int max_pixels = 0;          // Largest width * height of the encoded image
+        double min_scale = 0.25;     // Smallest downscale factor tried to meet max_bytes
+    };
+
+    // Encoded image and the settings that produced it
+    struct EncodedImage {
+        std::vector<uchar> bytes;
+        Format format = Format::Jpeg;
+        int quality = 0;
+        double scale = 1.0;          // Encoded pixels per input pixel
+        cv::Size size;
+        bool within_budget = true;   // False when max_bytes could not be met at min_quality and min_scale
+
+        bool empty() const {
+            return bytes.empty();
+        }
+    };
+
+    /**
+     * MIME type of an encoding format, for data URLs
+     * 
+     * @param format The encoding format
+     * @return const char* The MIME type, e.g. "image/jpeg"
+     */
+    const char* mimeType(Format format);
+
+    /**
+     * Parse a format name ("jpeg", "jpg", "png" or "webp")
+     * 
+     * @param name The format name, case insensitive
+     * @return Format The format
+     * @throws std::invalid_argument If the name is unknown
+     */
+    Format parseFormat(const std::string& name);
+
+    /**
+     * Encode an image, downscaling or lowering quality until the budgets are met
+     * 
+     * The pixel budget is applied first by downscaling. While the byte budget is
+     * exceeded, lossy formats lower their quality in steps down to min_quality,
+     * then the image is downscaled further down to min_scale.
+     * 
+     * @param image The BGR image to encode
+     * @param settings The format, quality and budgets
+     * @return EncodedImage The encoded bytes and the settings that were used
+     * @throws std::runtime_error If the format cannot be encoded by this OpenCV build
+     */
+    EncodedImage encode(const cv::Mat& image, const Settings& settings);
+
+    /**
+     * Describe the chosen settings for the debug output
+     * 
+     * @param encoded The encoded image
+     * @return nlohmann::json Format, quality, scale, size, byte count and budget flag
+     */
+    nlohmann::json describe(const EncodedImage& encoded);
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace GetCoordItemStore {
+    /**
+     * Struct-of-arrays copy of items.json, built once per load
+     *
+     * Items are numbered in the order the map stages draw them (items.json
+     * "items" object order). Strings live in one arena and are handed out as
+     * views; numeric fields are plain columns.
+     */
+    class ItemStore {
+    public:
+        /**
+         * Build the store from parsed items.json
+         * 
+         * @param items_data The JSON data with items information
+         * @return ItemStore The typed, indexed items
+         */
+        static ItemStore fromJson(const nlohmann::json& items_data);
+
+        size_t size() const {
+            return xs.size();
+        }
+
+        std::string_view id(size_t index) const {
+            return view(id_spans[index]);
+        }
+
+        std::string_view description(size_t index) const {
+            return view(description_spans[index]);
+        }
+
+        const std::string& className(size_t index) const {
+            return class_names[class_indices[index]];
+        }
+
+        // World position of the item center and its footprint in meters
+        double x(size_t index) const { return xs[index]; }
+        double y(size_t index) const { return ys[index]; }
+        double width(size_t index) const { return widths[index]; }
+        double height(size_t index) const { return heights[index]; }
+
+        // Class names in items.json "classes" order, followed by any class only found under "items"
+        const std::vector<std::string>& classes() const {
+            return class_names;
+        }
+
+        // Index of an item id, -1 when it is unknown; the first occurrence wins
+        int find(const std::string& item_id) const;
+
+        // Indices of the items of a class, empty when the class is unknown
+        const std::vector<uint32_t>& ofClass(const std::string& class_name) const;
+
+        /**
+         * Write a subset of the items back in the items.json layout
+         * 
+         * @param indices The items to write, in any order
+         * @return nlohmann::json The "classes" and "items" of the subset, in store order
+         */
+        nlohmann::json toJson(std::vector<uint32_t> indices) const;
+
+    private:
+        struct Span {
+            uint32_t offset = 0;
+            uint32_t length = 0;
+        };
+
+        std::string arena;
+        std::vector<Span> id_spans;
+        std::vector<Span> description_spans;
+        std::vector<uint16_t> class_indices;
+        std::vector<double> xs;
+        std::vector<double> ys;
+        std::vector<double> widths;
+        std::vector<double> heights;
+
+        std::vector<std::string> class_names;
+        std::unordered_map<std::string, uint32_t> by_id;
+        std::unordered_map<std::string, std::vector<uint32_t>> by_class;
+
+        Span append(const std::string& text);
+
+        std::string_view view(const Span& span) const {
+            return std::string_view(arena).substr(span.offset, span.length);
+        }
+    };
+}
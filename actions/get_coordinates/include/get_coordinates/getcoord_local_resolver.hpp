@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "get_coordinates/getcoord_item_store.hpp"
+#include "get_coordinates/getcoord_map_layers.hpp"
+#include "get_coordinates/getcoord_spatial_index.hpp"
+
+namespace GetCoordLocalResolver {
+    /**
+     * Lower case words of the item ids, classes and descriptions
+     *
+     * Ids are kept whole ("plant_003"); classes and description words map to
+     * the sorted indices of the items they occur in.
+     */
+    class TokenIndex {
+    public:
+        /**
+         * Build the index over the items
+         *
+         * @param items The items loaded from items.json
+         * @return TokenIndex The index, empty when there are no items
+         */
+        static TokenIndex build(const GetCoordItemStore::ItemStore& items);
+
+        // Item with this id, compared case-insensitively, -1 when unknown
+        int findId(const std::string& word) const;
+
+        // Items a word occurs in as class or description word, singular or plural; nullptr when none
+        const std::vector<uint32_t>* find(const std::string& word) const;
+
+    private:
+        std::unordered_map<std::string, uint32_t> ids;
+        std::unordered_map<std::string, std::vector<uint32_t>> postings;
+    };
+
+    enum class Outcome {
+        Resolved,   // Exactly one item fits, the LLM is not needed
+        Ambiguous,  // Several items fit and no qualifier tells them apart
+        Unmatched   // A word the index cannot interpret, or no item fits
+    };
+
+    struct Resolution {
+        Outcome outcome = Outcome::Unmatched;
+        // The resolved item first, otherwise every item that fits
+        std::vector<uint32_t> candidates;
+        // Why the request was or was not resolved, for the logs and the result message
+        std::string reason;
+    };
+
+    /**
+     * Match a description against the token index
+     *
+     * Every word must be an item id, a class or description word, a filler word or
+     * the qualifier "nearest"/"closest"; relations such as "next to" or unknown
+     * words like colours leave the request to the LLM.
+     *
+     * @param description The object description of the request
+     * @param tokens The token index of the items
+     * @param spatial The item footprints, used by the "nearest" qualifier
+     * @param robot The robot pose, "nearest" is only honoured when it is valid
+     * @return Resolution The outcome with its candidates
+     */
+    Resolution resolve(const std::string& description,
+                       const TokenIndex& tokens,
+                       const GetCoordSpatialIndex::SpatialIndex& spatial,
+                       const GetCoordMapLayers::RobotPose& robot);
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "get_coordinates/getcoord_item_store.hpp"
+#include "get_coordinates/getcoord_map_layers.hpp"
+#include "get_coordinates/getcoord_spatial_index.hpp"
+#include "get_coordinates/getcoord_local_resolver.hpp"
+#include "get_coordinates/getcoord_coord_validation.hpp"
+
+namespace GetCoordMapCache {
+    // Parameters that influence the derived rasters
+    struct PipelineParams {
+        float inflation_radius_m;
+        int scale_factor;
+        int grid_scale;
+
+        bool operator==(const PipelineParams& other) const = default;
+    };
+
+    // Everything derived from map.pgm, map.yaml and items.json
+    struct MapState {
+        GetCoordItemStore::ItemStore items;
+        // items.json as loaded, handed to the LLM without re-serializing
+        std::string items_text;
+        // Item footprints in world coordinates for proximity queries
+        GetCoordSpatialIndex::SpatialIndex spatial;
+        // Words of the item ids, classes and descriptions for the local resolver
+        GetCoordLocalResolver::TokenIndex tokens;
+        float resolution;
+        std::vector<float> origin;
+
+        float scaled_resolution;
+        // Typed planes the semantic stages produce, cacheable without any rendering
+        GetCoordMapLayers::MapLayers layers;
+        // Nearest free, item-free cell connected to the origin, for snapping returned pixels
+        GetCoordCoordValidation::SnapField snap;
+        // Annotated BGR image for the LLM, rendered from the layers
+        cv::Mat object_map;
+
+        // Incremented every time the pipeline is rebuilt
+        uint64_t version = 0;
+        // Hash of the input file contents and parameters, stable across processes
+        uint64_t content_hash = 0;
+    };
+
+    // Receives the state being replaced (built with the same parameters) or nullptr
+    using Builder = std::function<std::shared_ptr<MapState>(const std::shared_ptr<const MapState>& previous)>;
+
+    /**
+     * Return the map state for the given inputs, running the builder only when
+     * one of the input files really changed or the parameters differ
+     *
+     * Files are fingerprinted by mtime and size first; the content hash is only
+     * recomputed when those differ, so a touched but unchanged file keeps the cache.
+     * Neither the hashing nor the builder runs under the cache lock; concurrent
+     * callers for the same inputs wait for the one build in flight.
+     *
+     * @param map_path Path to map.pgm
+     * @param items_json_path Path to items.json
+     * @param map_yaml_path Path to map.yaml (may be missing)
+     * @param params The pipeline parameters
+     * @param build Callback producing a fresh map state on a cache miss, given the
+     *              outdated state so it can update derived rasters incrementally
+     * @return std::shared_ptr<const MapState> The cached or rebuilt map state
+     */
+    std::shared_ptr<const MapState> acquire(const std::string& map_path,
+                                            const std::string& items_json_path,
+                                            const std::string& map_yaml_path,
+                                            const PipelineParams& params,
+                                            const Builder& build);
+
+    /**
+     * Drop every cached map state, forcing a rebuild on the next acquire
+     */
+    void invalidate();
+}
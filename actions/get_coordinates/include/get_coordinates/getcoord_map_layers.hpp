@@ -0,0 +1,56 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+#include "get_coordinates/getcoord_walkability_generation.hpp"
+
+namespace GetCoordMapLayers {
+    // Robot pose in world and map pixel coordinates
+    struct RobotPose {
+        bool valid = false;
+        double x = 0.0;
+        double y = 0.0;
+        double yaw = 0.0;
+        cv::Point pixel{-1, -1};
+    };
+
+    /**
+     * Semantic planes of the scaled map
+     *
+     * Every stage after scaling reads and writes these typed planes; the annotated
+     * BGR image for the LLM is only rendered from them at the end.
+     */
+    struct MapLayers {
+        cv::Mat occupancy;  // CV_8U scaled map.pgm (0 occupied, 254 free, 205 unknown)
+        cv::Mat cost;       // CV_8U cost map (255 free, 70 inflation, 0 obstacle)
+        GetCoordWalkabilityGeneration::WalkabilityMap walkable;   // Bit set where cost is free, item boxes cleared
+        GetCoordWalkabilityGeneration::WalkabilityMap reachable;  // Bit set on free space connected to the origin
+        cv::Mat labels;     // CV_16U item store index + 1 per pixel, 0 where there is no item
+        cv::Point reachable_seed{-1, -1};    // Free cell the reachable plane was flood filled from
+        cv::Point origin_pixel{-1, -1};      // Map origin in pixels, clamped to the map
+
+        int rows() const {
+            return cost.rows;
+        }
+
+        int cols() const {
+            return cost.cols;
+        }
+
+        // Index of the item covering a pixel, -1 when none or outside the map
+        int itemIndexAt(int x, int y) const {
+            if (labels.empty() || x < 0 || y < 0 || x >= labels.cols || y >= labels.rows) {
+                return -1;
+            }
+            return static_cast<int>(labels.at<uint16_t>(y, x)) - 1;
+        }
+
+        bool isReachable(int x, int y) const {
+            if (reachable.empty() || x < -1 || y < -1 || x > reachable.cols || y > reachable.rows) {
+                return false;
+            }
+            return reachable.isWalkable(y, x);
+        }
+    };
+}
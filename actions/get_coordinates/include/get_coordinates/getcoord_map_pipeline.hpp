@@ -0,0 +1,73 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <functional>
+#include <string>
+#include "get_coordinates/getcoord_map_cache.hpp"
+
+namespace GetCoordMapPipeline {
+    // Parameters of processes 1-5
+    struct Settings {
+        float inflation_radius_m;
+        int scale_factor;
+        int grid_scale;
+        int tile_size;
+    };
+
+    // Receives a debug image and its file name. The image may be kept (e.g. queued for
+    // writing), so the pipeline only hands out rasters it will not modify afterwards
+    using ImageSink = std::function<void(const cv::Mat&, const std::string&)>;
+
+    /**
+     * Runs the map stages back to back on a small, fixed set of rasters
+     *
+     * The semantic stages only fill the typed planes of MapLayers. The annotated BGR
+     * image for the LLM is rendered from those planes at the end, on one scratch raster
+     * reused across runs; the final object map is the only BGR raster kept in the map state.
+     */
+    class MapPipeline {
+    public:
+        /**
+         * Build the layers and render the object map
+         * 
+         * @param map_img The grayscale map image
+         * @param settings The pipeline parameters
+         * @param previous The outdated map state built with the same settings, or nullptr
+         * @param state The map state to fill; resolution, origin and items must be set
+         * @param save_image Optional sink for debug images, nothing is rendered for it when empty
+         */
+        void run(const cv::Mat& map_img, const Settings& settings,
+                 const GetCoordMapCache::MapState* previous,
+                 GetCoordMapCache::MapState& state,
+                 const ImageSink& save_image = nullptr);
+
+        /**
+         * Processes 1-3 without rendering: occupancy, cost, walkable, reachable and label planes,
+         * and the snap field derived from them
+         * 
+         * @param map_img The grayscale map image
+         * @param settings The pipeline parameters
+         * @param previous The outdated map state built with the same settings, or nullptr
+         * @param state The map state whose layers are filled
+         * @param save_image Optional sink for debug images
+         */
+        void buildLayers(const cv::Mat& map_img, const Settings& settings,
+                         const GetCoordMapCache::MapState* previous,
+                         GetCoordMapCache::MapState& state,
+                         const ImageSink& save_image = nullptr);
+
+        /**
+         * Processes 3-5 as rendering only: draw the object map from the layers
+         * 
+         * @param settings The pipeline parameters
+         * @param state The map state with its layers built; object_map is written
+         * @param save_image Optional sink for debug images
+         */
+        void render(const Settings& settings, GetCoordMapCache::MapState& state,
+                    const ImageSink& save_image = nullptr);
+
+    private:
+        // BGR scratch raster: the non-traversable overlay, then the grid drawn on top of it
+        cv::Mat render_buffer;
+    };
+}
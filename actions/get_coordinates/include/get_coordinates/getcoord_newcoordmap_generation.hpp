@@ -3,7 +3,7 @@
 #include <opencv2/opencv.hpp>
 #include <nlohmann/json.hpp>
 #include <vector>
-#include <utility>
+#include "get_coordinates/getcoord_item_store.hpp"
 
 namespace GetCoordNewCoordmapGeneration {
     /**
@@ -13,12 +13,14 @@ namespace GetCoordNewCoordmapGeneration {
      * @param resolution The resolution of the map in meters per pixel
      * @param origin The origin coordinates of the map [x, y, z]
      * @param result The JSON result containing coordinates
-     * @param items_data The JSON data with items information
-     * @return std::pair<cv::Mat, float> The generated map with markers and the orientation angle
+     * @param items The items loaded from items.json
+     * @param angle_deg The approach yaw in degrees, drawn as a heading line
+     * @return cv::Mat The generated map with markers
      */
-    std::pair<cv::Mat, float> process(const cv::Mat& object_map, 
-                                    double resolution, 
-                                    const std::vector<float>& origin, 
-                                    const nlohmann::json& result,
-                                    const nlohmann::json& items_data);
+    cv::Mat process(const cv::Mat& object_map, 
+                    double resolution, 
+                    const std::vector<float>& origin, 
+                    const nlohmann::json& result,
+                    const GetCoordItemStore::ItemStore& items,
+                    float angle_deg);
 }
\ No newline at end of file
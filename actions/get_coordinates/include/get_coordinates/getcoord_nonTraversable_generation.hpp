@@ -1,9 +1,65 @@
 #pragma once
 
 #include <opencv2/opencv.hpp>
+#include <cstdint>
 #include <vector>
 
 namespace GetCoordNonTraversableGeneration {
+    /**
+     * Cost-to-come field over free space
+     *
+     * Holds the 8-connected chamfer cost from the seed to every reachable cell,
+     * so reachability and path distance queries are single array reads.
+     * Diagonal steps may not cut corners, so the reachable cells are the 4-connected ones.
+     */
+    struct ReachabilityField {
+        // Chamfer weights of a straight and a diagonal step; 7/5 is within 1% of sqrt(2)
+        static constexpr int32_t straight_cost = 5;
+        static constexpr int32_t diagonal_cost = 7;
+
+        int rows = 0;
+        int cols = 0;
+        double resolution = 0.0;
+        cv::Point requested{-1, -1};  // Point the field was asked for (robot or origin)
+        cv::Point seed{-1, -1};       // Free cell the flood fill actually started from, (-1, -1) if none
+        std::vector<int32_t> steps;   // Chamfer cost from the seed, -1 where unreachable
+
+        bool empty() const {
+            return steps.empty();
+        }
+
+        bool isReachable(int x, int y) const;
+
+        // Path distance from the seed in meters, or -1 when unreachable
+        double distance(int x, int y) const;
+    };
+
+    // Free space connected to the map origin
+    struct ReachableArea {
+        cv::Mat mask;                 // 255 where reachable, 0 elsewhere
+        cv::Point seed{-1, -1};       // Free cell the flood fill started from, (-1, -1) if there is no free space
+        cv::Point origin{-1, -1};     // Map origin in pixels, clamped to the map
+    };
+
+    /**
+     * Find the free space reachable from the map origin, without rendering anything
+     * 
+     * @param map_img The map image (grayscale or BGR)
+     * @param resolution The resolution of the map in meters per pixel
+     * @param origin The origin coordinates of the map [x, y, z]
+     * @return ReachableArea The reachable mask with its seed and origin pixels
+     */
+    ReachableArea findReachableArea(const cv::Mat& map_img, double resolution, const std::vector<float>& origin);
+
+    /**
+     * Render the map with the free space outside the reachable area marked red
+     * 
+     * @param map_img The map image the area was computed on, must not alias dst
+     * @param area The reachable area from findReachableArea
+     * @param dst The output BGR map, reused when it has the right size
+     */
+    void paintInto(const cv::Mat& map_img, const ReachableArea& area, cv::Mat& dst);
+
     /**
      * Process a map image to identify and mark non-traversable areas
      * 
@@ -13,4 +69,33 @@ namespace GetCoordNonTraversableGeneration {
      * @return cv::Mat The map with non-traversable areas marked
      */
     cv::Mat process(const cv::Mat& map_img, double resolution, const std::vector<float>& origin);
-}
\ No newline at end of file
+
+    /**
+     * Same as process(), but renders into a caller-owned BGR buffer
+     * 
+     * A single-channel map is classified directly, without building an intermediate
+     * BGR copy. dst is only reallocated when its size or type does not match.
+     * 
+     * @param map_img The input map image (grayscale or BGR), must not alias dst
+     * @param resolution The resolution of the map in meters per pixel
+     * @param origin The origin coordinates of the map [x, y, z]
+     * @param dst The output BGR map with non-traversable areas marked
+     */
+    void renderInto(const cv::Mat& map_img, double resolution, const std::vector<float>& origin, cv::Mat& dst);
+
+    /**
+     * Compute the reachability field from the robot's cell, or from the map origin if no robot is given
+     * 
+     * The origin seed falls back to the nearest free cell, then to any free cell of the map. The robot
+     * seed only falls back to a free cell near the robot: when the robot is off the map or boxed in,
+     * every cell of the field is unreachable and its seed is (-1, -1).
+     * 
+     * @param map_img The cost map (grayscale or BGR)
+     * @param resolution The resolution of the map in meters per pixel
+     * @param origin The origin coordinates of the map [x, y, z]
+     * @param robot_pixel The robot's pixel, or nullptr to seed at the map origin
+     * @return ReachabilityField The step count field from the seed
+     */
+    ReachabilityField computeReachability(const cv::Mat& map_img, double resolution,
+                                          const std::vector<float>& origin, const cv::Point* robot_pixel = nullptr);
+}
@@ -1,19 +1,60 @@
 #pragma once
 
 #include <opencv2/opencv.hpp>
-#include <nlohmann/json.hpp>
 #include <vector>
+#include "get_coordinates/getcoord_item_store.hpp"
 
 namespace GetCoordObjectMapGeneration {
     /**
-     * Process a grid map to generate an object map with items from JSON data
+     * Process a grid map to generate an object map with the stored items
      * 
      * @param grid_map The input grid map
      * @param resolution The resolution of the map in meters per pixel
      * @param origin The origin coordinates of the map [x, y, z]
-     * @param items_data The JSON data with items information
+     * @param items The items loaded from items.json
      * @return cv::Mat The generated object map with items drawn
      */
     cv::Mat process(const cv::Mat& grid_map, double resolution, 
-                  const std::vector<float>& origin, const nlohmann::json& items_data);
-}
\ No newline at end of file
+                  const std::vector<float>& origin, const GetCoordItemStore::ItemStore& items);
+
+    /**
+     * Same as process(), but renders into a caller-owned buffer
+     * 
+     * The grid map is only read; dst receives the overlay and the blend in place,
+     * so no copy of the input is kept besides dst itself.
+     * 
+     * @param grid_map The input grid map, must not alias dst
+     * @param resolution The resolution of the map in meters per pixel
+     * @param origin The origin coordinates of the map [x, y, z]
+     * @param items The items loaded from items.json
+     * @param dst The output BGR object map
+     */
+    void renderInto(const cv::Mat& grid_map, double resolution, 
+                    const std::vector<float>& origin, const GetCoordItemStore::ItemStore& items,
+                    cv::Mat& dst);
+
+    /**
+     * Padded box of an item in map pixels, the box drawn on the object map
+     * 
+     * @param items The items loaded from items.json
+     * @param index The item's store index
+     * @param resolution The resolution of the map in meters per pixel
+     * @param origin The origin coordinates of the map [x, y, z]
+     * @param size The map size in pixels
+     * @return cv::Rect The box, clamped to the map
+     */
+    cv::Rect itemBox(const GetCoordItemStore::ItemStore& items, size_t index, double resolution,
+                     const std::vector<float>& origin, const cv::Size& size);
+
+    /**
+     * Rasterize the item boxes into a 16-bit label map
+     * 
+     * @param size The map size in pixels
+     * @param resolution The resolution of the map in meters per pixel
+     * @param origin The origin coordinates of the map [x, y, z]
+     * @param items The items loaded from items.json
+     * @return cv::Mat CV_16UC1 map with store index + 1 of the item covering each pixel, 0 where there is none
+     */
+    cv::Mat labelMap(const cv::Size& size, double resolution, 
+                     const std::vector<float>& origin, const GetCoordItemStore::ItemStore& items);
+}
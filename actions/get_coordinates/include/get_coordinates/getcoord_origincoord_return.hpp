@@ -3,6 +3,7 @@
 #include <nlohmann/json.hpp>
 #include <vector>
 #include <utility>
+#include "get_coordinates/getcoord_roi_crop.hpp"
 
 namespace GetCoordOriginCoordReturn {
     /**
@@ -20,4 +21,14 @@ namespace GetCoordOriginCoordReturn {
                          const std::vector<float>& origin, 
                          const std::pair<int, int>& map_shape, 
                          double angle);
+
+    /**
+     * Convert pixel coordinates picked on a cropped view of the object map
+     * to object map pixel coordinates
+     * 
+     * @param result The JSON result containing pixel coordinates in the sent image
+     * @param view The crop and scale of the image that was sent
+     * @return nlohmann::json The result with object map pixel coordinates
+     */
+    nlohmann::json toMapPixels(const nlohmann::json& result, const GetCoordRoiCrop::RoiView& view);
 }
\ No newline at end of file
@@ -1,25 +1,64 @@
 #pragma once
 
-#include <opencv2/opencv.hpp>
 #include <nlohmann/json.hpp>
+#include "get_coordinates/getcoord_walkability_generation.hpp"
+#include "get_coordinates/getcoord_item_store.hpp"
+#include <string>
 #include <vector>
 
 namespace GetCoordPathfindReturn {
+    // Neighbourhood and heuristic used by the search
+    enum class SearchMode {
+        FourConnected,   // Unit steps, Euclidean heuristic
+        EightConnected,  // Diagonal steps cost sqrt(2) and may not cut corners, octile heuristic
+        JumpPoint        // Jump Point Search over the same 8-connected grid, prunes symmetric paths
+    };
+
     /**
      * Find a path from robot position to target object
      * 
-     * @param object_map The input object map
+     * The search ends at the first cell next to the item's box on the object map, the
+     * cheapest one. When no such cell is reachable, the reachable cell closest to the box
+     * is returned instead.
+     * 
+     * @param walkability The walkability bitmap derived from the cost map, item boxes blocked
      * @param resolution The resolution of the map in meters per pixel
      * @param origin The origin coordinates of the map [x, y, z]
-     * @param items_data The JSON data with items information
+     * @param items The item store built once from items.json
      * @param robot_coords The robot coordinates
      * @param assistant_reply The AI assistant reply containing target ID
-     * @return nlohmann::json The result with path finding coordinates
+     * @param mode The search mode
+     * @return nlohmann::json The result with path finding coordinates, path cost and distance to the item box
      */
-    nlohmann::json process(const cv::Mat& object_map, 
+    nlohmann::json process(const GetCoordWalkabilityGeneration::WalkabilityMap& walkability, 
                          double resolution, 
                          const std::vector<float>& origin, 
-                         const nlohmann::json& items_data, 
+                         const GetCoordItemStore::ItemStore& items, 
                          const nlohmann::json& robot_coords, 
-                         const nlohmann::json& assistant_reply);
-}
\ No newline at end of file
+                         const nlohmann::json& assistant_reply,
+                         SearchMode mode = SearchMode::FourConnected);
+
+    /**
+     * Find the reachable approach cell and its path cost for several items with one sweep
+     *
+     * A single Dijkstra wavefront is expanded from the robot; each item is then answered from it
+     * with the cheapest settled cell next to its box, else the settled cell closest to the box.
+     * JumpPoint runs one search per item instead, as process() does, which pays off for few items.
+     * 
+     * @param walkability The walkability bitmap derived from the cost map, item boxes blocked
+     * @param resolution The resolution of the map in meters per pixel
+     * @param origin The origin coordinates of the map [x, y, z]
+     * @param items The item store built once from items.json
+     * @param robot_coords The robot coordinates
+     * @param target_ids The ids of the items to evaluate
+     * @param mode The search mode
+     * @return nlohmann::json Array with, per target id, the approach pixel, path cost and its distance to the item box
+     */
+    nlohmann::json processBatch(const GetCoordWalkabilityGeneration::WalkabilityMap& walkability, 
+                              double resolution, 
+                              const std::vector<float>& origin, 
+                              const GetCoordItemStore::ItemStore& items, 
+                              const nlohmann::json& robot_coords, 
+                              const std::vector<std::string>& target_ids,
+                              SearchMode mode = SearchMode::FourConnected);
+}
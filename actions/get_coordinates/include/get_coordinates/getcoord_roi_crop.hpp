@@ -0,0 +1,42 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <cmath>
+#include <vector>
+
+namespace GetCoordRoiCrop {
+    // Where the image sent to the LLM sits in the object map
+    struct RoiView {
+        cv::Rect roi;        // Cropped region in object map pixels, empty for the whole map
+        double scale = 1.0;  // Sent image pixels per object map pixel
+
+        // Object map pixel of a pixel in the sent image
+        cv::Point toMap(double x, double y) const {
+            return cv::Point(roi.x + static_cast<int>(std::lround(x / scale)),
+                             roi.y + static_cast<int>(std::lround(y / scale)));
+        }
+    };
+
+    /**
+     * Bounding box of a set of pixels, padded and clipped to the map
+     * 
+     * @param points The pixels that must be visible, they may lie outside the map
+     * @param margin_px The padding added on every side in pixels
+     * @param min_edge_px The smallest edge length, the box grows around its center up to it
+     * @param map_size The size of the object map
+     * @return cv::Rect The region, the whole map when there are no points inside it
+     */
+    cv::Rect boundingRegion(const std::vector<cv::Point>& points, int margin_px, int min_edge_px, 
+                            const cv::Size& map_size);
+
+    /**
+     * Crop the object map to a region and shrink it to a bounded edge length
+     * 
+     * @param object_map The rendered object map
+     * @param roi The region to keep in object map pixels, empty for the whole map
+     * @param max_edge_px The longest edge of the result, 0 or less for no limit
+     * @param dst The cropped image, a view into object_map when no resize is needed
+     * @return RoiView The transform from dst pixels back to object map pixels
+     */
+    RoiView crop(const cv::Mat& object_map, const cv::Rect& roi, int max_edge_px, cv::Mat& dst);
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "get_coordinates/getcoord_item_store.hpp"
+
+namespace GetCoordSpatialIndex {
+    // Item footprint in world coordinates (meters)
+    struct Box {
+        double min_x = 0.0;
+        double min_y = 0.0;
+        double max_x = 0.0;
+        double max_y = 0.0;
+    };
+
+    /**
+     * Uniform grid of buckets over the item footprints
+     *
+     * Every item is listed in each cell its footprint overlaps, stored as one
+     * flat array with per-cell offsets. Indices refer to the ItemStore the
+     * index was built from. Distances are measured to the footprint edge, so
+     * a point inside a footprint is at distance 0.
+     */
+    class SpatialIndex {
+    public:
+        /**
+         * Build the index over the item footprints
+         *
+         * @param items The items loaded from items.json
+         * @param cell_size The bucket edge length in meters, 0 or less picks one from the item density
+         * @return SpatialIndex The index, empty when there are no items
+         */
+        static SpatialIndex build(const GetCoordItemStore::ItemStore& items, double cell_size = 0.0);
+
+        size_t size() const {
+            return boxes.size();
+        }
+
+        const Box& box(uint32_t index) const {
+            return boxes[index];
+        }
+
+        // Distance from a point to the footprint of an item
+        double distanceTo(uint32_t index, double x, double y) const;
+
+        /**
+         * The k items closest to a point, nearest first
+         *
+         * @param x The world x coordinate
+         * @param y The world y coordinate
+         * @param k The number of items to return
+         * @param out Receives the item indices, cleared first
+         */
+        void nearest(double x, double y, size_t k, std::vector<uint32_t>& out) const;
+
+        /**
+         * Items whose footprint is within a radius of a point, in index order
+         *
+         * @param x The world x coordinate
+         * @param y The world y coordinate
+         * @param radius The search radius in meters
+         * @param out Receives the item indices, cleared first
+         */
+        void withinRadius(double x, double y, double radius, std::vector<uint32_t>& out) const;
+
+        /**
+         * Items whose footprint is within a gap of another item's footprint, in index order
+         *
+         * @param index The item to search around, it is not part of the result
+         * @param gap The largest edge-to-edge distance in meters
+         * @param out Receives the item indices, cleared first
+         */
+        void adjacentTo(uint32_t index, double gap, std::vector<uint32_t>& out) const;
+
+    private:
+        std::vector<Box> boxes;
+
+        double cell_size = 1.0;
+        double grid_x = 0.0;            // World position of the grid's lower left corner
+        double grid_y = 0.0;
+        int cols = 0;
+        int rows = 0;
+        std::vector<uint32_t> cell_start;   // rows * cols + 1 offsets into cell_items
+        std::vector<uint32_t> cell_items;
+
+        int cellX(double x) const;
+        int cellY(double y) const;
+
+        // Items of the cells overlapping a query box, each reported once
+        template <typename Fn>
+        void forEachInBox(const Box& query, Fn&& fn) const;
+    };
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <functional>
+#include <vector>
+
+namespace GetCoordTiling {
+    // A tile of the map: the core region it writes and the halo-padded region it reads
+    struct Tile {
+        cv::Rect core;
+        cv::Rect padded;
+    };
+
+    /**
+     * Split an image into square tiles, each padded by a halo clipped to the image
+     * 
+     * @param size The image size
+     * @param tile_size The edge length of a tile core in pixels
+     * @param halo The number of extra pixels read around each core
+     * @return std::vector<Tile> The tiles, covering the image without overlapping cores
+     */
+    std::vector<Tile> makeTiles(const cv::Size& size, int tile_size, int halo);
+
+    /**
+     * Run a function on every tile using OpenCV's thread pool
+     * 
+     * @param tiles The tiles to process
+     * @param fn The function to run, it must only write inside the tile core
+     */
+    void forEachTile(const std::vector<Tile>& tiles, const std::function<void(const Tile&)>& fn);
+
+    /**
+     * Run a function on horizontal bands of rows using OpenCV's thread pool
+     * 
+     * @param rows The number of image rows
+     * @param band_rows The number of rows per band, 0 or less runs a single band on the calling thread
+     * @param fn The function to run on [row_begin, row_end)
+     */
+    void forEachRowBand(int rows, int band_rows, const std::function<void(int, int)>& fn);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace GetCoordWalkabilityGeneration {
+    /**
+     * Packed walkability bitmap with one bit per map cell
+     *
+     * The map is surrounded by a one-cell border of blocked cells, so any cell
+     * in [-1, rows] x [-1, cols] can be looked up without a bounds check.
+     */
+    struct WalkabilityMap {
+        int rows = 0;
+        int cols = 0;
+        size_t stride = 0;  // Bits per padded row, a multiple of 64
+        std::vector<uint64_t> bits;
+
+        bool empty() const {
+            return bits.empty();
+        }
+
+        bool isWalkable(int row, int col) const {
+            size_t bit = static_cast<size_t>(row + 1) * stride + static_cast<size_t>(col + 1);
+            return (bits[bit >> 6] >> (bit & 63)) & 1;
+        }
+    };
+
+    /**
+     * Derive the walkability bitmap from a cost map
+     *
+     * @param cost_map The single-channel cost map (255 free, 70 inflation, 0 obstacle)
+     * @return WalkabilityMap Bitmap where only free (255) cells are walkable
+     */
+    WalkabilityMap process(const cv::Mat& cost_map);
+
+    /**
+     * Pack any single-channel mask into the same bit layout
+     *
+     * @param mask The mask, non-zero cells are set
+     * @return WalkabilityMap Bitmap of the set cells
+     */
+    WalkabilityMap fromMask(const cv::Mat& mask);
+
+    /**
+     * Block the cells where a mask is set
+     *
+     * @param walkability The bitmap to update
+     * @param mask CV_8UC1 or CV_16UC1 mask of the same size, non-zero cells are cleared
+     */
+    void block(WalkabilityMap& walkability, const cv::Mat& mask);
+
+    /**
+     * Unpack a bitmap into a mask
+     *
+     * @param walkability The bitmap
+     * @return cv::Mat CV_8UC1 mask, 255 on set cells
+     */
+    cv::Mat toMask(const WalkabilityMap& walkability);
+}
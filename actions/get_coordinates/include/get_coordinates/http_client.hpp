@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <curl/curl.h>
+
+namespace get_coordinates {
+
+/**
+ * Process-wide HTTP client with a pool of reusable cURL easy handles
+ *
+ * All handles share one DNS cache, TLS session cache and connection cache,
+ * so a warm request skips name resolution and the TCP/TLS handshakes.
+ * HTTP/2 is negotiated over TLS where the server supports it.
+ * post() is safe to call from several threads.
+ */
+class HttpClient {
+public:
+    struct Response {
+        long status = 0;
+        std::string body;
+        // Connections opened for this request, 0 when a pooled connection was reused
+        long new_connections = 0;
+        double total_time_s = 0.0;
+    };
+
+    struct Stats {
+        uint64_t requests = 0;
+        uint64_t new_connections = 0;
+        uint64_t failures = 0;
+    };
+
+    // The process-lifetime client; cURL is initialized on first use
+    static HttpClient& instance();
+
+    HttpClient(const HttpClient&) = delete;
+    HttpClient& operator=(const HttpClient&) = delete;
+
+    /**
+     * Send a POST request, reusing a pooled handle and connection when possible
+     * 
+     * @param url The request URL
+     * @param headers The request headers, owned by the caller and kept alive across requests
+     * @param body The request body, sent without copying
+     * @param timeout_ms The whole-request timeout in milliseconds, 0 for none
+     * @return Response The status code and body
+     * @throws std::runtime_error If the transfer fails
+     */
+    Response post(const std::string& url, const curl_slist* headers, const std::string& body, 
+                  long timeout_ms = 0);
+
+    /**
+     * Open a connection to the URL's host ahead of the first request
+     * 
+     * Only the first call in the process connects; later calls return at once.
+     * Failures are not reported, the next post() connects again.
+     * 
+     * @param url Any URL on the host
+     * @param timeout_ms The whole-request timeout in milliseconds
+     */
+    void preconnect(const std::string& url, long timeout_ms = 5000);
+
+    Stats stats() const;
+
+    // [DEBUG HTTP] output, off unless GET_COORDINATES_HTTP_DEBUG is set
+    void setDebugLogging(bool enabled) { debug_logging = enabled; }
+
+private:
+    HttpClient();
+    ~HttpClient();
+
+    CURL* acquire();
+    void release(CURL* handle);
+
+    static void lockShare(CURL* handle, curl_lock_data data, curl_lock_access access, void* client);
+    static void unlockShare(CURL* handle, curl_lock_data data, void* client);
+
+    CURLSH* share = nullptr;
+    std::array<std::mutex, CURL_LOCK_DATA_LAST> share_locks;
+
+    std::mutex pool_mutex;
+    std::vector<CURL*> idle_handles;
+
+    std::once_flag preconnect_once;
+    std::atomic<bool> debug_logging{false};
+
+    std::atomic<uint64_t> request_count{0};
+    std::atomic<uint64_t> connection_count{0};
+    std::atomic<uint64_t> failure_count{0};
+};
+
+} // namespace get_coordinates
@@ -14,29 +14,32 @@ public:
     /**
      * Initialize the LLMCoordinator with data
      * 
-     * @param data_json The JSON data with items information
      * @param instructions The system instructions for the LLM
-     * @param map_data_str The map data as a string
+     * @param map_data_str The items.json content sent as the object list
      */
-    void initialize(const Json::Value& data_json, 
-                   const std::string& instructions,
+    void initialize(const std::string& instructions,
                    const std::string& map_data_str);
     
     /**
      * Search for coordinates based on object class and description
      * 
-     * @param message The JSON message containing object class and description
-     * @param object_map The base64-encoded image of the object map
+     * @param message The JSON message containing the description, and optionally
+     *                "objects": the items to offer instead of the full list
+     * @param object_map The object map as a data URL, or as base64-encoded JPEG
      * @return std::string The JSON response with coordinates
      */
-    std::string getcoord_search(const Json::Value& message, const Json::Value& object_map);
+    std::string getcoord_search(const Json::Value& message, const std::string& object_map);
+    
+    /**
+     * Open the connection to the LLM API ahead of the first request
+     */
+    void initialize_connection();
 
 private:
     // AI core for API calls
     AICore ai_core;
     
     // Data storage
-    Json::Value data;
     std::string map_data;
     std::string INSTRUCTIONS;
     
@@ -45,12 +48,14 @@ private:
      * 
      * @param object_description The object description
      * @param error_log Any error logs from previous attempts
-     * @param object_map The base64-encoded image of the object map
+     * @param object_map The object map as a data URL, or as base64-encoded JPEG
+     * @param object_list The items.json text listing the objects to choose from
      * @return std::string The JSON response with coordinates
      */
     std::string LLM_Search(const std::string& object_description, 
                           const std::string& error_log, 
-                          const Json::Value& object_map);
+                          const std::string& object_map,
+                          const std::string& object_list);
     
     // Logging methods
     void log_info(const std::string& message);
@@ -5,21 +5,12 @@
 #include <memory>
 #include <stdexcept>
 #include <regex>
+#include <mutex>
+#include <cstdlib>
+#include "get_coordinates/http_client.hpp"
 
 namespace get_coordinates {
 
-// Callback function for cURL to write response data
-static size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::string* s) {
-    size_t newLength = size * nmemb;
-    try {
-        s->append((char*)contents, newLength);
-        return newLength;
-    } catch(std::bad_alloc& e) {
-        // Handle memory problem
-        return 0;
-    }
-}
-
 /**
  * Extracts JSON data from LLM responses that may contain debug information or markdown code blocks
  * 
@@ -84,11 +75,18 @@ std::string extract_json_string_from_llm_response(const std::string& raw_respons
 
 AICore::AICore() {
     std::cout << "[DEBUG AI] AICore constructor called" << std::endl;
-    // Initialize with default values
+    // Initialize with default values; the environment can point the client elsewhere, e.g. at a mock server
     api_endpoint = "https://api.openai.com/v1/chat/completions";
+    if (const char* endpoint = std::getenv("GET_COORDINATES_LLM_ENDPOINT")) {
+        api_endpoint = endpoint;
+    }
+    std::string key_path = "/home/fyier/CHATGPT_KEY";
+    if (const char* path = std::getenv("GET_COORDINATES_LLM_KEY_FILE")) {
+        key_path = path;
+    }
     
     // Load API key from file
-    std::ifstream key_file("/home/fyier/CHATGPT_KEY");
+    std::ifstream key_file(key_path);
     if (key_file.is_open()) {
         std::getline(key_file, api_key);
         key_file.close();
@@ -107,47 +105,27 @@ AICore::AICore() {
     if (api_key.empty()) {
         std::cout << "[DEBUG AI] Warning: API key is empty" << std::endl;
     }
-    
-    // Initialize cURL globally - should be called once per application
-    curl_global_init(CURL_GLOBAL_ALL);
-    std::cout << "[DEBUG AI] cURL initialized globally" << std::endl;
 }
 
 AICore::~AICore() {
-    // Clean up cURL global resources
-    curl_global_cleanup();
-    std::cout << "[DEBUG AI] AICore destructor called, cURL cleaned up" << std::endl;
+    // Handles and connections belong to the process-wide HTTP client
+    if (headers) {
+        curl_slist_free_all(headers);
+    }
+    std::cout << "[DEBUG AI] AICore destructor called" << std::endl;
 }
 
-std::string AICore::AI_Image_Prompt(const std::string& messages,
+std::string AICore::AI_Image_Prompt(ChatRequestBuilder& messages,
                                    double temperature,
                                    int max_tokens,
                                    double frequency_penalty,
                                    double presence_penalty) {
     std::cout << "[DEBUG AI] AI_Image_Prompt called" << std::endl;
-    std::cout << "[DEBUG AI] messages length: " << messages.length() << std::endl;
+    std::cout << "[DEBUG AI] messages length: " << messages.size() << std::endl;
     
-    // Create request payload 
-    Json::Value payload;
-    Json::Reader reader;
-    bool parse_success = reader.parse(messages, payload["messages"]);
-    
-    if (!parse_success) {
-        std::cout << "[DEBUG AI] Failed to parse messages JSON" << std::endl;
-        throw std::runtime_error("Failed to parse messages JSON");
-    }
-    std::cout << "[DEBUG AI] Successfully parsed messages JSON" << std::endl;
-    
-    // Set model and parameters
-    payload["model"] = "gpt-4o";
-    payload["temperature"] = temperature;
-    payload["max_tokens"] = max_tokens;
-    payload["frequency_penalty"] = frequency_penalty;
-    payload["presence_penalty"] = presence_penalty;
-    
-    // Convert payload to string
-    Json::FastWriter writer;
-    std::string request_data = writer.write(payload);
+    // Close the body with the model and parameters; the messages are never re-parsed
+    std::string request_data = messages.finish("gpt-4o", temperature, max_tokens, 
+                                               frequency_penalty, presence_penalty);
     std::cout << "[DEBUG AI] Request data prepared, length: " << request_data.length() << std::endl;
     
     // Check if API key is set
@@ -216,92 +194,80 @@ std::string AICore::createDummyResponse() {
     return writer.write(response);
 }
 
+void AICore::prepare_headers() {
+    if (headers) {
+        return;
+    }
+    headers = curl_slist_append(headers, "Content-Type: application/json");
+    std::string auth_header = "Authorization: Bearer " + api_key;
+    headers = curl_slist_append(headers, auth_header.c_str());
+}
+
 void AICore::initialize_connection() {
     std::cout << "[DEBUG AI] initialize_connection called" << std::endl;
-    // Placeholder for any connection initialization that needs to be done
-    // For example, setting up connection pools, authentication, etc.
+    prepare_headers();
+    if (connection_ready) {
+        return;
+    }
+
+    // Leave a warm connection to the endpoint in the shared pool
+    HttpClient::instance().preconnect(api_endpoint);
+    connection_ready = true;
 }
 
 std::string AICore::send_request(const std::string& payload) {
     std::cout << "[DEBUG AI] send_request called with payload length: " << payload.length() << std::endl;
     
-    CURL* curl = curl_easy_init();
-    std::string response_string;
+    // Pooled handle and connection from the process-wide client
+    prepare_headers();
+    HttpClient::Response http_response = HttpClient::instance().post(api_endpoint, headers, payload, request_timeout_ms);
+    std::string& response_string = http_response.body;
     
-    if (curl) {
-        struct curl_slist* headers = NULL;
-        headers = curl_slist_append(headers, "Content-Type: application/json");
-        std::string auth_header = "Authorization: Bearer " + api_key;
-        headers = curl_slist_append(headers, auth_header.c_str());
-        
-        curl_easy_setopt(curl, CURLOPT_URL, api_endpoint.c_str());
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, payload.c_str());
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_string);
-        
-        // Perform the request
-        std::cout << "[DEBUG AI] Performing cURL request" << std::endl;
-        CURLcode res = curl_easy_perform(curl);
-        
-        // Check for errors
-        if (res != CURLE_OK) {
-            std::cout << "[DEBUG AI] cURL request failed: " << curl_easy_strerror(res) << std::endl;
-            curl_slist_free_all(headers);
-            curl_easy_cleanup(curl);
-            throw std::runtime_error(std::string("cURL request failed: ") + curl_easy_strerror(res));
-        }
-        
-        std::cout << "[DEBUG AI] cURL request successful, response length: " << response_string.length() << std::endl;
-        std::cout << "[DEBUG AI] Full API response: " << response_string << std::endl;
-        
-        // Clean up
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
-        
-        // Parse the response to extract just the AI's reply
-        Json::Value response_json;
-        Json::Reader reader;
-        
-        if (reader.parse(response_string, response_json)) {
-            std::cout << "[DEBUG AI] Successfully parsed response as JSON" << std::endl;
-            // For GPT-4 Vision, the content should be in choices[0].message.content
-            try {
-                if (response_json.isMember("choices") && response_json["choices"].isArray() && 
-                    response_json["choices"].size() > 0 && 
-                    response_json["choices"][0].isMember("message") && 
-                    response_json["choices"][0]["message"].isMember("content")) {
-                    
-                    std::string assistant_content = response_json["choices"][0]["message"]["content"].asString();
-                    std::cout << "[DEBUG AI] Extracted assistant content, length: " << assistant_content.length() << std::endl;
-                    
-                    // The key change: Extract any JSON from the assistant_content
-                    // This will handle cases where the assistant includes text and JSON in code blocks
-                    std::string extracted_json = extract_json_string_from_llm_response(assistant_content);
-                    if (extracted_json != "{}") {
-                        std::cout << "[DEBUG AI] Found valid JSON in assistant content" << std::endl;
-                        return extracted_json;
-                    }
-                    
-                    // Return the full content if no JSON was found
-                    return assistant_content;
-                } else {
-                    std::cout << "[DEBUG AI] Response JSON doesn't have expected structure" << std::endl;
-                    // Return the full response to let LLM coordinator handle the error
-                    return response_string;
+    std::cout << "[DEBUG AI] cURL request successful, status: " << http_response.status 
+              << ", response length: " << response_string.length() 
+              << ", new connections: " << http_response.new_connections 
+              << ", time: " << http_response.total_time_s << " s" << std::endl;
+    std::cout << "[DEBUG AI] Full API response: " << response_string << std::endl;
+    
+    // Parse the response to extract just the AI's reply
+    Json::Value response_json;
+    Json::Reader reader;
+    
+    if (reader.parse(response_string, response_json)) {
+        std::cout << "[DEBUG AI] Successfully parsed response as JSON" << std::endl;
+        // For GPT-4 Vision, the content should be in choices[0].message.content
+        try {
+            if (response_json.isMember("choices") && response_json["choices"].isArray() && 
+                response_json["choices"].size() > 0 && 
+                response_json["choices"][0].isMember("message") && 
+                response_json["choices"][0]["message"].isMember("content")) {
+                
+                std::string assistant_content = response_json["choices"][0]["message"]["content"].asString();
+                std::cout << "[DEBUG AI] Extracted assistant content, length: " << assistant_content.length() << std::endl;
+                
+                // The key change: Extract any JSON from the assistant_content
+                // This will handle cases where the assistant includes text and JSON in code blocks
+                std::string extracted_json = extract_json_string_from_llm_response(assistant_content);
+                if (extracted_json != "{}") {
+                    std::cout << "[DEBUG AI] Found valid JSON in assistant content" << std::endl;
+                    return extracted_json;
                 }
-            } catch (const std::exception& e) {
-                std::cerr << "Error parsing API response: " << e.what() << std::endl;
-                std::cout << "[DEBUG AI] Error extracting content: " << e.what() << std::endl;
-                return response_string; // Return full response if we can't parse it
+                
+                // Return the full content if no JSON was found
+                return assistant_content;
+            } else {
+                std::cout << "[DEBUG AI] Response JSON doesn't have expected structure" << std::endl;
+                // Return the full response to let LLM coordinator handle the error
+                return response_string;
             }
-        } else {
-            std::cout << "[DEBUG AI] Failed to parse response as JSON" << std::endl;
-            return response_string; // Return raw response if JSON parsing fails
+        } catch (const std::exception& e) {
+            std::cerr << "Error parsing API response: " << e.what() << std::endl;
+            std::cout << "[DEBUG AI] Error extracting content: " << e.what() << std::endl;
+            return response_string; // Return full response if we can't parse it
         }
     } else {
-        std::cout << "[DEBUG AI] Failed to initialize cURL" << std::endl;
-        throw std::runtime_error("Failed to initialize cURL");
+        std::cout << "[DEBUG AI] Failed to parse response as JSON" << std::endl;
+        return response_string; // Return raw response if JSON parsing fails
     }
 }
 
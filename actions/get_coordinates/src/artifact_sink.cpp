@@ -0,0 +1,123 @@
+#include "get_coordinates/artifact_sink.hpp"
+#include <fstream>
+#include <iostream>
+
+namespace get_coordinates {
+
+ArtifactSink::ArtifactSink(Mode mode, size_t max_queued)
+    : sink_mode(mode), max_queued(max_queued) {
+    if (sink_mode == Mode::Async) {
+        writer = std::thread(&ArtifactSink::writerLoop, this);
+    }
+}
+
+ArtifactSink::~ArtifactSink() {
+    if (writer.joinable()) {
+        // Write whatever is still queued before shutting down
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            stopping = true;
+        }
+        queue_changed.notify_all();
+        writer.join();
+    }
+}
+
+void ArtifactSink::saveImage(const std::string& path, const cv::Mat& image) {
+    Artifact artifact;
+    artifact.path = path;
+    artifact.image = image;
+    artifact.is_image = true;
+    submit(std::move(artifact));
+}
+
+void ArtifactSink::saveText(const std::string& path, std::string contents) {
+    Artifact artifact;
+    artifact.path = path;
+    artifact.text = std::move(contents);
+    submit(std::move(artifact));
+}
+
+void ArtifactSink::flush() {
+    std::unique_lock<std::mutex> lock(queue_mutex);
+    queue_changed.wait(lock, [this]() { return queue.empty() && !writing; });
+}
+
+ArtifactSink::Stats ArtifactSink::stats() const {
+    Stats stats;
+    stats.written = written.load();
+    stats.dropped = dropped.load();
+    stats.failed = failed.load();
+    return stats;
+}
+
+void ArtifactSink::submit(Artifact artifact) {
+    switch (sink_mode) {
+        case Mode::Off:
+            return;
+        case Mode::Sync:
+            write(artifact);
+            return;
+        case Mode::Async:
+            break;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        // Never make the request wait for the disk; drop the artifact instead
+        if (queue.size() >= max_queued) {
+            ++dropped;
+            std::cout << "Artifact queue full, dropped: " << artifact.path << std::endl;
+            return;
+        }
+        queue.push_back(std::move(artifact));
+    }
+    queue_changed.notify_all();
+}
+
+void ArtifactSink::write(const Artifact& artifact) {
+    bool ok = false;
+    try {
+        if (artifact.is_image) {
+            ok = cv::imwrite(artifact.path, artifact.image);
+        } else {
+            std::ofstream file(artifact.path);
+            file << artifact.text;
+            ok = static_cast<bool>(file);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to write " << artifact.path << ": " << e.what() << std::endl;
+    }
+
+    if (ok) {
+        ++written;
+        std::cout << "Saved artifact to: " << artifact.path << std::endl;
+    } else {
+        ++failed;
+        std::cerr << "Failed to write artifact: " << artifact.path << std::endl;
+    }
+}
+
+void ArtifactSink::writerLoop() {
+    std::unique_lock<std::mutex> lock(queue_mutex);
+    while (true) {
+        queue_changed.wait(lock, [this]() { return stopping || !queue.empty(); });
+        if (queue.empty()) {
+            // Only reached when stopping with nothing left to write
+            return;
+        }
+
+        Artifact artifact = std::move(queue.front());
+        queue.pop_front();
+        writing = true;
+        lock.unlock();
+
+        write(artifact);
+
+        lock.lock();
+        writing = false;
+        queue_changed.notify_all();
+    }
+}
+
+} // namespace get_coordinates
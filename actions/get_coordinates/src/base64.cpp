@@ -0,0 +1,167 @@
+#include "get_coordinates/base64.hpp"
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GET_COORDINATES_BASE64_X86 1
+#include <immintrin.h>
+#endif
+
+namespace get_coordinates {
+
+static const char base64_table[] = 
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Encode whole 3-byte groups and the padded tail
+static void encodeScalar(const uint8_t* data, size_t length, char* out) {
+    size_t i = 0;
+    for (; i + 3 <= length; i += 3) {
+        uint32_t triple = (uint32_t(data[i]) << 16) | (uint32_t(data[i + 1]) << 8) | data[i + 2];
+        out[0] = base64_table[(triple >> 18) & 0x3F];
+        out[1] = base64_table[(triple >> 12) & 0x3F];
+        out[2] = base64_table[(triple >> 6) & 0x3F];
+        out[3] = base64_table[triple & 0x3F];
+        out += 4;
+    }
+
+    size_t rest = length - i;
+    if (rest > 0) {
+        uint32_t triple = uint32_t(data[i]) << 16;
+        if (rest == 2) {
+            triple |= uint32_t(data[i + 1]) << 8;
+        }
+        out[0] = base64_table[(triple >> 18) & 0x3F];
+        out[1] = base64_table[(triple >> 12) & 0x3F];
+        out[2] = rest == 2 ? base64_table[(triple >> 6) & 0x3F] : '=';
+        out[3] = '=';
+    }
+}
+
+#ifdef GET_COORDINATES_BASE64_X86
+// Split 12 bytes (in 16-byte lanes) into sixteen 6-bit indices, one per byte
+__attribute__((target("ssse3")))
+static inline __m128i unpackSSSE3(__m128i in) {
+    in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+    __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+    __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t1, t3);
+}
+
+// Map 6-bit indices to ASCII by adding a per-range offset
+__attribute__((target("ssse3")))
+static inline __m128i lookupSSSE3(__m128i indices) {
+    const __m128i shift_lut = _mm_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+        '/' - 63, 'A', 0, 0);
+    __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    range = _mm_or_si128(range, _mm_and_si128(upper, _mm_set1_epi8(13)));
+    return _mm_add_epi8(_mm_shuffle_epi8(shift_lut, range), indices);
+}
+
+__attribute__((target("ssse3")))
+static void encodeSSSE3(const uint8_t* data, size_t length, char* out) {
+    // Each step reads 16 bytes but consumes 12
+    size_t i = 0;
+    for (; i + 16 <= length; i += 12) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), lookupSSSE3(unpackSSSE3(in)));
+        out += 16;
+    }
+    encodeScalar(data + i, length - i, out);
+}
+
+__attribute__((target("avx2")))
+static void encodeAVX2(const uint8_t* data, size_t length, char* out) {
+    const __m256i shuffle = _mm256_set_epi8(
+        10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+        10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    const __m256i shift_lut = _mm256_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+        '/' - 63, 'A', 0, 0,
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+        '/' - 63, 'A', 0, 0);
+
+    // Each step reads two 16-byte lanes 12 bytes apart and consumes 24 bytes
+    size_t i = 0;
+    for (; i + 28 <= length; i += 24) {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 12));
+        __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+
+        in = _mm256_shuffle_epi8(in, shuffle);
+        __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+        __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+        __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        __m256i indices = _mm256_or_si256(t1, t3);
+
+        __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+        range = _mm256_or_si256(range, _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+        __m256i ascii = _mm256_add_epi8(_mm256_shuffle_epi8(shift_lut, range), indices);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), ascii);
+        out += 32;
+    }
+    encodeSSSE3(data + i, length - i, out);
+}
+#endif
+
+using EncodeFunction = void (*)(const uint8_t*, size_t, char*);
+
+struct Encoder {
+    EncodeFunction encode;
+    const char* name;
+};
+
+// Picked once per process from the CPU features
+static Encoder selectEncoder() {
+#ifdef GET_COORDINATES_BASE64_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return {encodeAVX2, "avx2"};
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        return {encodeSSSE3, "ssse3"};
+    }
+#endif
+    return {encodeScalar, "scalar"};
+}
+
+static const Encoder& encoder() {
+    static const Encoder selected = selectEncoder();
+    return selected;
+}
+
+void base64Encode(const uint8_t* data, size_t length, char* out) {
+    encoder().encode(data, length, out);
+}
+
+std::string base64DataUrl(const std::string& mime_type, const uint8_t* data, size_t length) {
+    static const char scheme[] = "data:";
+    static const char marker[] = ";base64,";
+    size_t prefix = sizeof(scheme) - 1 + mime_type.size() + sizeof(marker) - 1;
+
+    std::string url(prefix + base64EncodedLength(length), '\0');
+    char* out = &url[0];
+    std::memcpy(out, scheme, sizeof(scheme) - 1);
+    out += sizeof(scheme) - 1;
+    std::memcpy(out, mime_type.data(), mime_type.size());
+    out += mime_type.size();
+    std::memcpy(out, marker, sizeof(marker) - 1);
+    out += sizeof(marker) - 1;
+
+    base64Encode(data, length, out);
+    return url;
+}
+
+const char* base64Implementation() {
+    return encoder().name;
+}
+
+} // namespace get_coordinates
@@ -0,0 +1,109 @@
+#include "get_coordinates/chat_request_builder.hpp"
+#include <cstdio>
+#include <stdexcept>
+#include <utility>
+
+namespace get_coordinates {
+
+ChatRequestBuilder::ChatRequestBuilder(size_t reserve_bytes) {
+    body.reserve(reserve_bytes + 256);
+    body += "{\"messages\":[";
+}
+
+void ChatRequestBuilder::beginMessage(const std::string& role) {
+    if (!first_message) {
+        body += ',';
+    }
+    first_message = false;
+    first_part = true;
+
+    body += "{\"role\":";
+    appendString(role);
+    body += ",\"content\":[";
+}
+
+void ChatRequestBuilder::beginPart() {
+    if (!first_part) {
+        body += ',';
+    }
+    first_part = false;
+}
+
+void ChatRequestBuilder::addText(const std::string& text) {
+    beginPart();
+    body += "{\"type\":\"text\",\"text\":";
+    appendString(text);
+    body += '}';
+}
+
+void ChatRequestBuilder::addImageUrl(const std::string& url) {
+    beginPart();
+    body += "{\"type\":\"image_url\",\"image_url\":{\"url\":";
+    appendString(url);
+    body += "}}";
+}
+
+void ChatRequestBuilder::endMessage() {
+    body += "]}";
+}
+
+std::string ChatRequestBuilder::finish(const std::string& model, double temperature, int max_tokens,
+                                       double frequency_penalty, double presence_penalty) {
+    body += "],\"model\":";
+    appendString(model);
+    body += ",\"temperature\":";
+    appendNumber(temperature);
+    body += ",\"max_tokens\":";
+    body += std::to_string(max_tokens);
+    body += ",\"frequency_penalty\":";
+    appendNumber(frequency_penalty);
+    body += ",\"presence_penalty\":";
+    appendNumber(presence_penalty);
+    body += '}';
+    return std::move(body);
+}
+
+void ChatRequestBuilder::appendString(const std::string& text) {
+    body += '"';
+
+    // Copy runs of plain characters in one go; base64 payloads are a single run
+    const char* data = text.data();
+    size_t run_start = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(data[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+
+        body.append(data + run_start, i - run_start);
+        run_start = i + 1;
+        switch (c) {
+            case '"': body += "\\\""; break;
+            case '\\': body += "\\\\"; break;
+            case '\n': body += "\\n"; break;
+            case '\r': body += "\\r"; break;
+            case '\t': body += "\\t"; break;
+            case '\b': body += "\\b"; break;
+            case '\f': body += "\\f"; break;
+            default: {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                body += escaped;
+            }
+        }
+    }
+    body.append(data + run_start, text.size() - run_start);
+
+    body += '"';
+}
+
+void ChatRequestBuilder::appendNumber(double value) {
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    if (length <= 0 || length >= static_cast<int>(sizeof(buffer))) {
+        throw std::runtime_error("Failed to format request parameter");
+    }
+    body.append(buffer, length);
+}
+
+} // namespace get_coordinates
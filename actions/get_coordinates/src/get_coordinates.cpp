@@ -41,39 +41,25 @@ bool onRun()
   TEMOTO_PRINT_OF(output, getName());
  
   try {
-    // Use relative path for data files
-    std::string package_share_dir = ament_index_cpp::get_package_share_directory("get_coordinates");
-    
-    // Navigate up to workspace root (from install/share/get_coordinates)
-    std::filesystem::path workspace_path = std::filesystem::path(package_share_dir) / "../../../..";
-    workspace_path = std::filesystem::canonical(workspace_path);
-    
-    // Set data paths
-    const std::string DATA_DIR = (workspace_path / "data").string();
-    const std::string ITEMS_JSON_PATH = DATA_DIR + "/items.json";
-    const std::string MAP_PATH = DATA_DIR + "/map.pgm";
-    const std::string MAP_YAML_PATH = DATA_DIR + "/map.yaml";   
-      
-    // Hardcode robot position to (0, 0)
-    json robot_position = {
-       {"x", 0.0},
-       {"y", 0.0}
-    };
+    const DataPaths paths = resolveDataPaths();
+    const json robot_position = robotPosition();
      
     TEMOTO_PRINT_OF("Calling findCoordinates for: " + params_in.location, getName());
     
     // Call the findCoordinates function from get_coordinates_run.cpp
     json result = findCoordinates(
-        MAP_PATH,           // Map image path
-        ITEMS_JSON_PATH,    // Items JSON path
-        MAP_YAML_PATH,      // Map YAML path
-        DATA_DIR,           // Output directory
+        paths.map,          // Map image path
+        paths.items_json,   // Items JSON path
+        paths.map_yaml,     // Map YAML path
+        paths.data_dir,     // Output directory
         params_in.location, // Object description (using the same value)
         robot_position      // Hardcoded robot position
     );
     
     // Print the result for debugging
     TEMOTO_PRINT_OF("Coordinate search result: " + result.dump(2), getName());
+    TEMOTO_PRINT_OF("Decision cache: " + decisionCacheStats().dump(), getName());
+    TEMOTO_PRINT_OF("Request paths: " + requestPathStats().dump(), getName());
     
     // Check if coordinates were found successfully
     bool success = false;
@@ -151,6 +137,26 @@ bool onRun()
 void onInit()
 {
   TEMOTO_PRINT_OF("Initializing", getName());
+
+  if (!EAGER_WARMUP)
+  {
+    return;
+  }
+
+  // Build the map pipeline, encode the object map and open the LLM client now,
+  // so that the first navigation request is served from a warm state
+  try {
+    const DataPaths paths = resolveDataPaths();
+    TEMOTO_PRINT_OF("Warming up coordinate finder", getName());
+
+    if (warmupCoordinates(paths.map, paths.items_json, paths.map_yaml, paths.data_dir, robotPosition())) {
+      TEMOTO_PRINT_OF("Coordinate finder is warm", getName());
+    } else {
+      TEMOTO_PRINT_OF("Warmup failed, the first request will prepare the map instead", getName());
+    }
+  } catch (const std::exception& e) {
+    TEMOTO_PRINT_OF("Warmup exception: " + std::string(e.what()), getName());
+  }
 }
 
 void onPause()
@@ -172,6 +178,46 @@ void onStop()
 {
 }
 
+private:
+
+// Prepare the map and LLM client in onInit instead of on the first onRun
+static constexpr bool EAGER_WARMUP = true;
+
+struct DataPaths
+{
+  std::string data_dir;
+  std::string items_json;
+  std::string map;
+  std::string map_yaml;
+};
+
+DataPaths resolveDataPaths() const
+{
+  // Use relative path for data files
+  std::string package_share_dir = ament_index_cpp::get_package_share_directory("get_coordinates");
+  
+  // Navigate up to workspace root (from install/share/get_coordinates)
+  std::filesystem::path workspace_path = std::filesystem::path(package_share_dir) / "../../../..";
+  workspace_path = std::filesystem::canonical(workspace_path);
+  
+  // Set data paths
+  DataPaths paths;
+  paths.data_dir = (workspace_path / "data").string();
+  paths.items_json = paths.data_dir + "/items.json";
+  paths.map = paths.data_dir + "/map.pgm";
+  paths.map_yaml = paths.data_dir + "/map.yaml";
+  return paths;
+}
+
+json robotPosition() const
+{
+  // Hardcode robot position to (0, 0)
+  return {
+     {"x", 0.0},
+     {"y", 0.0}
+  };
+}
+
 }; // GetCoordinates class
 
 // REQUIRED, do not remove
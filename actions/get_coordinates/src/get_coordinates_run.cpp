@@ -7,10 +7,18 @@
 #include <unordered_set>
 #include <queue>
 #include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
 #include <opencv2/opencv.hpp>
 #include <nlohmann/json.hpp>
 #include <yaml-cpp/yaml.h>
 #include <filesystem>
+#include <condition_variable>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
 
 // Include custom script headers
 #include "get_coordinates/getcoord_scalemap_generation.hpp"
@@ -21,9 +29,20 @@
 #include "get_coordinates/getcoord_pixelcoord_return.hpp"
 #include "get_coordinates/getcoord_newcoordmap_generation.hpp"
 #include "get_coordinates/getcoord_origincoord_return.hpp"
+#include "get_coordinates/getcoord_roi_crop.hpp"
+#include "get_coordinates/getcoord_image_encoding.hpp"
 #include "get_coordinates/getcoord_robotmap_generation.hpp"
+#include "get_coordinates/getcoord_map_cache.hpp"
+#include "get_coordinates/getcoord_map_pipeline.hpp"
+#include "get_coordinates/getcoord_decision_cache.hpp"
+#include "get_coordinates/getcoord_local_resolver.hpp"
+#include "get_coordinates/getcoord_pathfind_return.hpp"
+#include "get_coordinates/getcoord_approach_pose.hpp"
+#include "get_coordinates/getcoord_coord_validation.hpp"
 #include "get_coordinates/ai_core.hpp"
 #include "get_coordinates/llm_coordinator.hpp"
+#include "get_coordinates/artifact_sink.hpp"
+#include "get_coordinates/base64.hpp"
 
 #include "get_coordinates/get_coordinates_run.hpp"
 #include <ament_index_cpp/get_package_share_directory.hpp>
@@ -38,26 +57,103 @@ const std::string ITEMS_JSON_PATH = DATA_DIR + "/items.json";
 const std::string MAP_PATH = DATA_DIR + "/map.pgm";
 const std::string MAP_YAML_PATH = DATA_DIR + "/map.yaml";
 
-// Define a simple RobotTransform struct to pass robot position
-struct RobotTransform {
-    double x;
-    double y;
+// State every coordinate finder on the same inputs shares: the LLM decisions and how
+// requests were answered. Both are safe to use from concurrent requests.
+struct SharedRequestState {
+    explicit SharedRequestState(const GetCoordDecisionCache::Settings& settings)
+        : decision_cache(settings) {}
+
+    GetCoordDecisionCache::DecisionCache decision_cache;
+    std::atomic<uint64_t> local{0};
+    std::atomic<uint64_t> cached{0};
+    std::atomic<uint64_t> llm{0};
+
+    // How many requests were resolved locally, served from the decision cache or sent to the LLM
+    json describePaths() const {
+        uint64_t local_count = local;
+        uint64_t total = local_count + cached + llm;
+        return {
+            {"local", local_count},
+            {"decision_cache", cached.load()},
+            {"llm", llm.load()},
+            {"local_rate", total == 0 ? 0.0 : static_cast<double>(local_count) / total}
+        };
+    }
 };
 
 class CoordinateFinder {
+public:
+    // LLM decisions reused for the same description, map state and robot cell; set disk_dir
+    // to keep them across restarts
+    static inline const GetCoordDecisionCache::Settings decision_cache_settings = [] {
+        GetCoordDecisionCache::Settings settings;
+        settings.capacity = 256;
+        settings.ttl_s = 3600.0;
+        settings.pose_quantum_m = 0.5;
+        return settings;
+    }();
+
 private:
     // Configuration parameters
     float inflation_radius_m = 0.2;
     int scale_factor = 2;
     int grid_scale = 20; // in px
+    int tile_size = 1024; // in px, tiles/row bands processed in parallel, 0 for serial
     float resolution = 0.05;
     std::vector<float> origin = {0.0, 0.0, 0.0};
+    // Robot displacement after which the reachability field is recomputed
+    float reachability_refresh_m = 0.25;
+    // Returned pixels that are off the map, blocked or unreachable are moved to the nearest
+    // valid cell; a request fails when that cell is farther than this
+    float max_snap_m = 2.0;
+    // Items offered to the LLM: those of the classes the request names, items within this
+    // gap of them, and the items nearest to the robot; every item when no class is named
+    float neighbourhood_gap_m = 1.0;
+    size_t nearby_item_count = 5;
+    // Send the LLM only the part of the object map around the robot and the offered items
+    bool roi_crop = true;
+    float roi_margin_m = 2.0;
+    int roi_min_edge_px = 256;
+    // Longest edge of the image sent to the LLM, bounding the payload on any map size
+    int roi_max_edge_px = 1024;
+    // Encoded object map regions kept per rendering, so the whole map encoded by warmup
+    // survives requests that send a crop
+    size_t max_encoded_regions = 4;
+    // Format, quality and byte/pixel budget of the image sent to the LLM
+    GetCoordImageEncoding::Settings llm_image_encoding = [] {
+        GetCoordImageEncoding::Settings settings;
+        settings.format = GetCoordImageEncoding::Format::Jpeg;
+        settings.quality = 95;
+        settings.max_bytes = 512 * 1024;
+        return settings;
+    }();
+    // Descriptions that fit exactly one item are answered without the LLM
+    bool local_resolver = true;
+    // Standoff rings sampled around the target when the pose is computed locally
+    GetCoordApproachPose::Settings approach_pose;
+    // Ambiguous matches up to this many items are checked with one jump point search each,
+    // more with a single wavefront from the robot
+    size_t jump_point_max_targets = 4;
+
+    // Input files, loaded through the map cache
+    std::string items_json_path;
+    std::string map_yaml_path;
 
-    // Data storage
-    json items_data;
+    // Map state shared with other requests on the same inputs
+    std::shared_ptr<const GetCoordMapCache::MapState> map_state;
+    // Stage chain with its reusable scratch raster
+    GetCoordMapPipeline::MapPipeline pipeline;
+    // Map state version the LLM coordinator was initialized with
+    uint64_t llm_state_version = 0;
+    // Decisions and request counters shared with the other finders, and the map content
+    // hash this finder last made decisions on
+    std::shared_ptr<SharedRequestState> shared;
+    uint64_t decision_map_hash = 0;
     
     // Output directory for saving images
     std::string output_dir;
+    // Writer for debug images and JSON files: Off, Async (bounded queue, drops when full) or Sync
+    get_coordinates::ArtifactSink artifacts{get_coordinates::ArtifactSink::Mode::Async, 16};
 
     // AI stuff
     std::string COORDINATES_METHOD = "oneCoordSearch";
@@ -65,40 +161,21 @@ private:
     get_coordinates::LLMCoordinator llm_coordinator;
     // For storing the object map
     cv::Mat object_map;
-
-    // Base64 encoding function
-    std::string base64_encode(const unsigned char* data, size_t length) {
-        static const char* encoding_table = 
-            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-        static const char padding_char = '=';
-        
-        std::string encoded;
-        encoded.reserve(((length + 2) / 3) * 4);  // Reserve space for the encoded string
-        
-        for (size_t i = 0; i < length; i += 3) {
-            uint32_t octet_a = i < length ? data[i] : 0;
-            uint32_t octet_b = i + 1 < length ? data[i + 1] : 0;
-            uint32_t octet_c = i + 2 < length ? data[i + 2] : 0;
-            
-            uint32_t triple = (octet_a << 16) + (octet_b << 8) + octet_c;
-            
-            encoded.push_back(encoding_table[(triple >> 18) & 0x3F]);
-            encoded.push_back(encoding_table[(triple >> 12) & 0x3F]);
-            encoded.push_back(encoding_table[(triple >> 6) & 0x3F]);
-            encoded.push_back(encoding_table[triple & 0x3F]);
-        }
-        
-        // Add padding if needed
-        size_t mod = length % 3;
-        if (mod == 1) {
-            encoded[encoded.size() - 1] = padding_char;
-            encoded[encoded.size() - 2] = padding_char;
-        } else if (mod == 2) {
-            encoded[encoded.size() - 1] = padding_char;
-        }
-        
-        return encoded;
-    }
+    // Map state version and robot pose object_map was rendered for
+    uint64_t rendered_state_version = 0;
+    GetCoordMapLayers::RobotPose robot_pose;
+    // A region of object_map as sent to the LLM
+    struct EncodedRegion {
+        cv::Rect roi;
+        GetCoordRoiCrop::RoiView view;
+        std::string data;  // Data URL
+    };
+    // Regions sent so far, least recently used first, cleared whenever object_map is re-rendered
+    std::vector<EncodedRegion> encoded_regions;
+    // Flood fill distances from the robot (or the map origin), and the map state version they belong to
+    GetCoordNonTraversableGeneration::ReachabilityField reachability_field;
+    uint64_t reachability_state_version = 0;
+    bool reachability_from_robot = false;
 
     // Internal helper methods
     json loadJsonFile(const std::string& filepath) {
@@ -145,16 +222,13 @@ private:
         }
     }
 
-    std::string encodeImageToBase64(const cv::Mat& image) {
-        std::vector<uchar> buffer;
-        cv::imencode(".png", image, buffer);
-        return base64_encode(buffer.data(), buffer.size());
-    }
-    
+    // Debug artifacts go through the sink so they stay off the request path
     void saveImage(const cv::Mat& image, const std::string& filename) {
-        std::string filepath = output_dir + "/" + filename;
-        cv::imwrite(filepath, image);
-        std::cout << "Saved image to: " << filepath << std::endl;
+        artifacts.saveImage(output_dir + "/" + filename, image);
+    }
+
+    void saveJson(const json& data, const std::string& filename) {
+        artifacts.saveText(output_dir + "/" + filename, data.dump(4));
     }
 
     // Convert world coordinates to pixel coordinates
@@ -228,34 +302,14 @@ private:
             For response do not include: ```json
             )";
 
-        // Check items_data before passing it
-        std::cout << "DEBUG INIT_LLM: About to dump items_data" << std::endl;
-        std::string items_data_str;
-        try {
-            items_data_str = items_data.dump();
-            std::cout << "DEBUG INIT_LLM: items_data dump successful, length: " << items_data_str.length() << std::endl;
-            if (items_data_str.length() > 100) {
-                std::cout << "DEBUG INIT_LLM: items_data preview: " << items_data_str.substr(0, 50) << "..." << std::endl;
-            } else {
-                std::cout << "DEBUG INIT_LLM: items_data: " << items_data_str << std::endl;
-            }
-        } catch (const json::exception& e) {
-            std::cerr << "DEBUG INIT_LLM: JSON error dumping items_data: " << e.what() << std::endl;
-            throw;
-        }
+        // items.json is sent as loaded; the store only serves the map stages
+        const std::string& items_text = map_state->items_text;
+        std::cout << "DEBUG INIT_LLM: items text length: " << items_text.length() << std::endl;
 
-        // Convert nlohmann::json to Json::Value
-        Json::Value jsonCpp_items_data;
-        Json::Reader reader;
-        
-        if (!reader.parse(items_data_str, jsonCpp_items_data)) {
-            throw std::runtime_error("Failed to convert items_data to Json::Value");
-        }
-        
-        // Initialize the coordinator with the converted Json::Value
+        // Initialize the coordinator
         std::cout << "DEBUG INIT_LLM: About to call llm_coordinator.initialize" << std::endl;
         try {
-            llm_coordinator.initialize(jsonCpp_items_data, instructions, items_data_str);
+            llm_coordinator.initialize(instructions, items_text);
             std::cout << "DEBUG INIT_LLM: Successfully initialized llm_coordinator" << std::endl;
         } catch (const std::exception& e) {
             std::cerr << "DEBUG INIT_LLM: Error in llm_coordinator.initialize: " << e.what() << std::endl;
@@ -263,24 +317,26 @@ private:
         }
     }
 
-public:
-    CoordinateFinder(const std::string& items_json_path, const std::string& output_directory, const std::string& map_yaml_path = "") 
-        : output_dir(output_directory) {
-        std::cout << "DEBUG CONSTRUCTOR: Starting constructor" << std::endl;
-        
+    // Load the inputs and run the map pipeline, called by the map cache on a miss
+    std::shared_ptr<GetCoordMapCache::MapState> buildMapState(
+        const std::string& map_path,
+        const std::shared_ptr<const GetCoordMapCache::MapState>& previous
+    ) {
+        auto state = std::make_shared<GetCoordMapCache::MapState>();
+
         // Load items data from JSON
-        std::cout << "DEBUG CONSTRUCTOR: About to load JSON file: " << items_json_path << std::endl;
+        std::cout << "DEBUG BUILD: About to load JSON file: " << items_json_path << std::endl;
         try {
-            items_data = loadJsonFile(items_json_path);
-            std::cout << "DEBUG CONSTRUCTOR: Successfully loaded items_data" << std::endl;
-            // Inspect the top-level structure
-            std::cout << "DEBUG CONSTRUCTOR: items_data keys: ";
-            for (auto& [key, val] : items_data.items()) {
-                std::cout << key << " ";
-            }
-            std::cout << std::endl;
+            // JSON is only kept as text for the LLM; the stages read the typed store
+            json items_data = loadJsonFile(items_json_path);
+            state->items = GetCoordItemStore::ItemStore::fromJson(items_data);
+            state->items_text = items_data.dump();
+            state->spatial = GetCoordSpatialIndex::SpatialIndex::build(state->items);
+            state->tokens = GetCoordLocalResolver::TokenIndex::build(state->items);
+            std::cout << "DEBUG BUILD: Successfully loaded " << state->items.size() << " items in "
+                      << state->items.classes().size() << " classes" << std::endl;
         } catch (const json::exception& e) {
-            std::cerr << "DEBUG CONSTRUCTOR: JSON error loading items_data: " << e.what() << std::endl;
+            std::cerr << "DEBUG BUILD: JSON error loading items: " << e.what() << std::endl;
             throw;
         }
         
@@ -296,6 +352,8 @@ public:
             std::cerr << "Using default values: resolution=" << resolution 
                       << ", origin=[" << origin[0] << "," << origin[1] << "," << origin[2] << "]" << std::endl;
         }
+        state->resolution = resolution;
+        state->origin = origin;
         
         // Create JSON file with current parameters
         json params = {
@@ -306,109 +364,546 @@ public:
             {"origin", {origin[0], origin[1], origin[2]}}
         };
         
-        std::ofstream param_file(output_dir + "/parameters.json");
-        param_file << params.dump(4);
-        param_file.close();
+        saveJson(params, "parameters.json");
+
+        // Load map
+        cv::Mat map_img = cv::imread(map_path, cv::IMREAD_GRAYSCALE);
+        if (map_img.empty()) {
+            throw std::runtime_error("Failed to load map image");
+        }
+        saveImage(map_img, "01_original_map.png");
+
+        // Processes 1-5
+        GetCoordMapPipeline::ImageSink save_image;
+        if (artifacts.mode() != get_coordinates::ArtifactSink::Mode::Off) {
+            save_image = [this](const cv::Mat& image, const std::string& filename) { saveImage(image, filename); };
+        }
+        pipeline.run(map_img, {inflation_radius_m, scale_factor, grid_scale, tile_size}, previous.get(), *state, save_image);
+
+        // Process 6: Convert items coordinates to pixel coordinates for AI processing
+        json pixel_coords = GetCoordPixelCoordReturn::process(
+            state->items, state->scaled_resolution, origin, {state->object_map.rows, state->object_map.cols}
+        );
         
-        // Initialize the LLM Coordinator
-        std::cout << "DEBUG CONSTRUCTOR: About to initialize LLM Coordinator" << std::endl;
-        try {
+        // Save the pixel coordinates to a JSON file
+        saveJson(pixel_coords, "07_pixel_coordinates.json");
+
+        return state;
+    }
+
+    // Acquire the cached map state and render the request specific object map
+    void prepareMap(const std::string& map_path, const json& robot_position) {
+        // Processes 1-6 only run when an input file or parameter changed
+        map_state = GetCoordMapCache::acquire(
+            map_path, items_json_path, map_yaml_path,
+            {inflation_radius_m, scale_factor, grid_scale},
+            [&](const std::shared_ptr<const GetCoordMapCache::MapState>& previous) {
+                return buildMapState(map_path, previous);
+            }
+        );
+        resolution = map_state->resolution;
+        origin = map_state->origin;
+
+        // Re-initialize the LLM Coordinator only when the items changed
+        if (llm_state_version != map_state->version) {
             initializeLLMCoordinator();
-            std::cout << "DEBUG CONSTRUCTOR: Successfully initialized LLM Coordinator" << std::endl;
-        } catch (const std::exception& e) {
-            std::cerr << "DEBUG CONSTRUCTOR: Error initializing LLM Coordinator: " << e.what() << std::endl;
-            throw;
+            llm_state_version = map_state->version;
+        }
+
+        // Decisions made on a map or items.json that changed since can never be hit again
+        if (decision_map_hash != map_state->content_hash) {
+            if (decision_map_hash != 0) {
+                shared->decision_cache.invalidateMap(decision_map_hash);
+            }
+            decision_map_hash = map_state->content_hash;
+        }
+
+        // The robot marker is request specific, so it is drawn on top of the cached object map
+        GetCoordMapLayers::RobotPose new_robot_pose;
+        new_robot_pose.valid = !robot_position.empty() && robot_position.contains("x") && robot_position.contains("y");
+        if (new_robot_pose.valid) {
+            // Get robot coordinates
+            new_robot_pose.x = robot_position["x"];
+            new_robot_pose.y = robot_position["y"];
+            new_robot_pose.yaw = robot_position.value("yaw", 0.0);
+            
+            // Convert robot world coordinates to pixel coordinates for visualization
+            auto robot_pixel = worldToPixel(new_robot_pose.x, new_robot_pose.y, map_state->layers.rows(), map_state->scaled_resolution);
+            new_robot_pose.pixel = cv::Point(robot_pixel.first, robot_pixel.second);
+        }
+        updateReachability(new_robot_pose);
+
+        // Nothing to re-render when neither the map nor the robot pixel changed
+        if (rendered_state_version == map_state->version && robot_pose.pixel == new_robot_pose.pixel) {
+            robot_pose = new_robot_pose;
+            return;
+        }
+        object_map = map_state->object_map;
+        robot_pose = new_robot_pose;
+        rendered_state_version = map_state->version;
+        encoded_regions.clear();
+
+        if (robot_pose.valid) {
+            // Draw robot position on the cost map for visualization, only if it is written anywhere
+            if (artifacts.mode() != get_coordinates::ArtifactSink::Mode::Off) {
+                cv::Mat cost_map_color;
+                cv::cvtColor(map_state->layers.cost, cost_map_color, cv::COLOR_GRAY2BGR);
+                cv::circle(cost_map_color, robot_pose.pixel, 5, cv::Scalar(0, 0, 255), -1);
+                saveImage(cost_map_color, "03b_cost_map_with_robot.png");
+            }
+
+            object_map = map_state->object_map.clone();
+            cv::circle(object_map, robot_pose.pixel, 5, cv::Scalar(0, 0, 255), -1);
         }
     }
 
-    // Modified findCoordinates to work with just object description
-    json findCoordinates(const std::string& map_path, const std::string& object_description, const json& robot_position = json()) {
-        
-        bool success_map_init = false;
-        // Declare these variables at the top of the function so they're accessible in all scopes
-        cv::Mat scaled_img;
-        float scaled_resolution;
-        json result;
-        
-        try {
-            // Load map
-            cv::Mat map_img = cv::imread(map_path, cv::IMREAD_GRAYSCALE);
-            if (map_img.empty()) {
-                throw std::runtime_error("Failed to load map image");
+    // Recompute the reachability field only when the map changed or the robot moved far enough.
+    // Without a robot pose the field is seeded at the map origin; a robot off the map gets a
+    // field in which nothing is reachable, not the origin's field
+    void updateReachability(const GetCoordMapLayers::RobotPose& pose) {
+        bool has_robot = pose.valid;
+        const cv::Point& new_robot_point = pose.pixel;
+        if (has_robot) {
+            bool on_map = new_robot_point.x >= 0 && new_robot_point.x < map_state->layers.cols()
+                       && new_robot_point.y >= 0 && new_robot_point.y < map_state->layers.rows();
+            if (!on_map) {
+                std::cout << "Warning: Robot pose (" << pose.x << ", " << pose.y << ") is outside the map at pixel (" 
+                          << new_robot_point.x << ", " << new_robot_point.y << "), no cell is reachable from it" << std::endl;
             }
-            saveImage(map_img, "01_original_map.png");
+        }
 
-            // Process 1: Scale map
-            std::tie(scaled_img, scaled_resolution) = GetCoordScaleMapGeneration::process(map_img, resolution, scale_factor);
-            saveImage(scaled_img, "02_scaled_map.png");
+        if (!reachability_field.empty() && reachability_state_version == map_state->version
+            && reachability_from_robot == has_robot) {
+            if (!has_robot) {
+                return;
+            }
+            // A field without a seed is cheap to redo and must not outlive a pose that has one
+            double moved_px = cv::norm(new_robot_point - reachability_field.requested);
+            if (reachability_field.seed.x >= 0 
+                && moved_px * map_state->scaled_resolution <= reachability_refresh_m) {
+                return;
+            }
+        }
 
-            // Process 2: Generate cost map
-            cv::Mat cost_map = GetCoordCostmapGeneration::process(scaled_img, scaled_resolution, inflation_radius_m);
-            saveImage(cost_map, "03_cost_map.png");
+        reachability_field = GetCoordNonTraversableGeneration::computeReachability(
+            map_state->layers.cost, map_state->scaled_resolution, origin, has_robot ? &new_robot_point : nullptr
+        );
+        reachability_state_version = map_state->version;
+        reachability_from_robot = has_robot;
+        std::cout << "Debug: Recomputed reachability field from (" 
+                  << reachability_field.seed.x << ", " << reachability_field.seed.y << ")" << std::endl;
+    }
 
-            // Convert cost_map to color for further processing
-            cv::Mat cost_map_color;
-            cv::cvtColor(cost_map, cost_map_color, cv::COLOR_GRAY2BGR);
+    // Check the chosen pixel and move it to the nearest valid cell when it is off the map,
+    // blocked or unreachable; false when no valid cell is within max_snap_m
+    bool validateCoordinates(json& result) const {
+        if (!result.contains("coordinates") || !result["coordinates"]["x"].is_number() 
+            || !result["coordinates"]["y"].is_number()) {
+            return true;
+        }
 
-            // Process 3: Darken non-traversable areas
-            cv::Mat non_traversable_map;
-            
-            // If robot position is provided, use it for non-traversable areas
-            if (!robot_position.empty() && robot_position.contains("x") && robot_position.contains("y")) {
-                // Get robot coordinates
-                RobotTransform robot_transform;
-                robot_transform.x = robot_position["x"];
-                robot_transform.y = robot_position["y"];
-                
-                // Convert robot world coordinates to pixel coordinates for visualization
-                auto robot_pixel = worldToPixel(robot_transform.x, robot_transform.y, scaled_img.rows, scaled_resolution);
-                
-                // Draw robot position on the cost map for visualization
-                cv::circle(cost_map_color, cv::Point(robot_pixel.first, robot_pixel.second), 5, cv::Scalar(0, 0, 255), -1);
-                saveImage(cost_map_color, "03b_cost_map_with_robot.png");
-                
-                // For debugging - create a proper implementation that uses the robot position
-                non_traversable_map = GetCoordNonTraversableGeneration::process(cost_map_color, scaled_resolution, origin);
-                
-                // Mark non-traversable areas in a more visible way for debugging
-                cv::Mat debug_map = non_traversable_map.clone();
-                
-                // Find black pixels (non-traversable areas) and make them red
-                for (int y = 0; y < debug_map.rows; y++) {
-                    for (int x = 0; x < debug_map.cols; x++) {
-                        cv::Vec3b pixel = debug_map.at<cv::Vec3b>(y, x);
-                        // If pixel is very dark (non-traversable)
-                        if (pixel[0] < 50 && pixel[1] < 50 && pixel[2] < 50) {
-                            debug_map.at<cv::Vec3b>(y, x) = cv::Vec3b(0, 0, 200); // Red in BGR
-                        }
-                    }
+        cv::Point pixel(static_cast<int>(result["coordinates"]["x"].get<double>()),
+                        static_cast<int>(result["coordinates"]["y"].get<double>()));
+        GetCoordCoordValidation::Check check = GetCoordCoordValidation::validate(
+            map_state->layers, reachability_field, map_state->snap, pixel, map_state->scaled_resolution, max_snap_m
+        );
+        bool snapped = check.status != GetCoordCoordValidation::Status::Valid && check.snapped.x >= 0;
+        result["validation"] = {
+            {"status", GetCoordCoordValidation::toString(check.status)},
+            {"snapped", snapped},
+            {"snap_distance_m", check.moved_m},
+            {"requested_pixel", {{"x", check.requested.x}, {"y", check.requested.y}}}
+        };
+        std::cout << "Debug: Target pixel (" << pixel.x << ", " << pixel.y << ") is " 
+                  << GetCoordCoordValidation::toString(check.status);
+        if (check.status == GetCoordCoordValidation::Status::Valid) {
+            std::cout << std::endl;
+            return true;
+        }
+        if (!snapped || check.moved_m > max_snap_m) {
+            std::cout << ", no valid cell within " << max_snap_m << " m" << std::endl;
+            return false;
+        }
+
+        result["coordinates"]["x"] = check.snapped.x;
+        result["coordinates"]["y"] = check.snapped.y;
+        std::cout << ", snapped to (" << check.snapped.x << ", " << check.snapped.y << "), " 
+                  << check.moved_m << " m away" << std::endl;
+        return true;
+    }
+
+    // Add reachability and path distance of the chosen pixel to the LLM result
+    void annotateReachability(json& result) const {
+        if (!result.contains("coordinates") || !result["coordinates"]["x"].is_number() 
+            || !result["coordinates"]["y"].is_number()) {
+            return;
+        }
+
+        const auto& field = reachability_field;
+        if (field.empty()) {
+            return;
+        }
+
+        int x = static_cast<int>(result["coordinates"]["x"].get<double>());
+        int y = static_cast<int>(result["coordinates"]["y"].get<double>());
+        result["reachable"] = field.isReachable(x, y);
+        result["path_distance_m"] = field.distance(x, y);
+        // Item box the chosen pixel falls into, "" when it is clear of all items
+        int item_index = map_state->layers.itemIndexAt(x, y);
+        result["pixel_item"] = item_index >= 0 ? std::string(map_state->items.id(item_index)) : "";
+        std::cout << "Debug: Target pixel (" << x << ", " << y << ") reachable: " 
+                  << result["reachable"] << ", path distance: " << result["path_distance_m"] << " m" << std::endl;
+    }
+
+    // Items relevant to a request, empty when the whole list should be sent
+    std::vector<uint32_t> relevantItems(const std::string& object_description) const {
+        const auto& items = map_state->items;
+        const auto& spatial = map_state->spatial;
+
+        // Words of the description, lower case
+        std::vector<std::string> words;
+        std::string word;
+        for (char c : object_description + " ") {
+            if (std::isalnum(static_cast<unsigned char>(c)) || c == '_') {
+                word.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+            } else if (!word.empty()) {
+                words.push_back(word);
+                word.clear();
+            }
+        }
+
+        // Classes named in the description, singular or plural
+        std::vector<uint32_t> selected;
+        for (const auto& item_class : items.classes()) {
+            std::string name = item_class;
+            std::transform(name.begin(), name.end(), name.begin(), 
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            for (const auto& w : words) {
+                if (w == name || w == name + "s" || w == name + "es") {
+                    const auto& members = items.ofClass(item_class);
+                    selected.insert(selected.end(), members.begin(), members.end());
+                    break;
                 }
-                
-                saveImage(debug_map, "04_debug_non_traversable.png");
-            } else {
-                // No robot position, just use the basic non-traversable function
-                non_traversable_map = GetCoordNonTraversableGeneration::process(cost_map_color, scaled_resolution, origin);
             }
-            
-            saveImage(non_traversable_map, "04_non_traversable_map.png");
+        }
+        if (selected.empty()) {
+            return {};
+        }
 
-            // Process 4: Create grid
-            cv::Mat grid_map = GetCoordGridGeneration::process(non_traversable_map, scaled_resolution, grid_scale);
-            saveImage(grid_map, "05_grid_map.png");
+        // Their surroundings, for descriptions like "chair next to fridge"
+        std::vector<uint32_t> neighbours;
+        size_t named_count = selected.size();
+        for (size_t i = 0; i < named_count; ++i) {
+            spatial.adjacentTo(selected[i], neighbourhood_gap_m, neighbours);
+            selected.insert(selected.end(), neighbours.begin(), neighbours.end());
+        }
+        if (robot_pose.valid) {
+            spatial.nearest(robot_pose.x, robot_pose.y, nearby_item_count, neighbours);
+            selected.insert(selected.end(), neighbours.begin(), neighbours.end());
+        }
 
-            // Process 5: Populate map with objects
-            object_map = GetCoordObjectMapGeneration::process(grid_map, scaled_resolution, origin, items_data);
-            saveImage(object_map, "06_object_map.png");
+        std::sort(selected.begin(), selected.end());
+        selected.erase(std::unique(selected.begin(), selected.end()), selected.end());
+        if (selected.size() == items.size()) {
+            return {};
+        }
+        std::cout << "Debug: Offering " << selected.size() << " of " << items.size() << " items to the LLM" << std::endl;
+        return selected;
+    }
 
-            // Process 6: Convert items coordinates to pixel coordinates for AI processing
-            json pixel_coords = GetCoordPixelCoordReturn::process(
-                items_data, scaled_resolution, origin, {object_map.rows, object_map.cols}
-            );
+    // Region of the object map around the robot and the candidate items (every item when empty)
+    cv::Rect requestRegion(const std::vector<uint32_t>& candidates) const {
+        cv::Rect whole(0, 0, object_map.cols, object_map.rows);
+        if (!roi_crop) {
+            return whole;
+        }
+
+        const auto& items = map_state->items;
+        const auto& spatial = map_state->spatial;
+        float res = map_state->scaled_resolution;
+        int rows = map_state->layers.rows();
+        std::vector<cv::Point> points;
+        auto addWorld = [&](double x, double y) {
+            points.emplace_back(static_cast<int>((x - origin[0]) / res), 
+                                rows - static_cast<int>((y - origin[1]) / res) - 1);
+        };
+        auto addItem = [&](uint32_t index) {
+            const auto& box = spatial.box(index);
+            addWorld(box.min_x, box.min_y);
+            addWorld(box.max_x, box.max_y);
+        };
+        if (candidates.empty()) {
+            for (uint32_t i = 0; i < items.size(); ++i) {
+                addItem(i);
+            }
+        } else {
+            for (uint32_t index : candidates) {
+                addItem(index);
+            }
+        }
+        if (robot_pose.valid) {
+            points.push_back(robot_pose.pixel);
+        }
+
+        int margin_px = static_cast<int>(std::ceil(roi_margin_m / res));
+        return GetCoordRoiCrop::boundingRegion(points, margin_px, roi_min_edge_px, whole.size());
+    }
+
+    // Data URL of an object map region, encoded once per rendering and region
+    const EncodedRegion& encodedObjectMap(const cv::Rect& roi) {
+        auto cached = std::find_if(encoded_regions.begin(), encoded_regions.end(),
+                                   [&roi](const EncodedRegion& region) { return region.roi == roi; });
+        if (cached != encoded_regions.end()) {
+            std::cout << "Debug: Reusing encoded object map region " << roi << std::endl;
+            std::rotate(cached, cached + 1, encoded_regions.end());
+            return encoded_regions.back();
+        }
+        if (!encoded_regions.empty() && encoded_regions.size() >= max_encoded_regions) {
+            encoded_regions.erase(encoded_regions.begin());
+        }
+
+        EncodedRegion region;
+        region.roi = roi;
+        cv::Mat sent_map;
+        region.view = GetCoordRoiCrop::crop(object_map, roi, roi_max_edge_px, sent_map);
+        std::cout << "Debug: Sending object map region " << region.view.roi << " at scale " 
+                  << region.view.scale << std::endl;
+
+        GetCoordImageEncoding::EncodedImage encoded = GetCoordImageEncoding::encode(sent_map, llm_image_encoding);
+        region.view.scale *= encoded.scale;
+        json encoding_info = GetCoordImageEncoding::describe(encoded);
+        std::cout << "Debug: Image encoded: " << encoding_info.dump() << std::endl;
+        if (!encoded.within_budget) {
+            std::cerr << "Warning: LLM image exceeds the byte budget of " << llm_image_encoding.max_bytes << std::endl;
+        }
+        saveJson(encoding_info, "08a_llm_image_encoding.json");
+
+        region.data = get_coordinates::base64DataUrl(GetCoordImageEncoding::mimeType(encoded.format), 
+                                                     encoded.bytes.data(), encoded.bytes.size());
+        encoded_regions.push_back(std::move(region));
+        return encoded_regions.back();
+    }
+
+    // Box of an item in object map pixels, the one drawn for the LLM and in the label plane
+    cv::Rect itemBox(uint32_t index) const {
+        return GetCoordObjectMapGeneration::itemBox(
+            map_state->items, index, map_state->scaled_resolution, origin,
+            cv::Size(map_state->layers.cols(), map_state->layers.rows())
+        );
+    }
+
+    // Drop the candidates of an ambiguous resolution the robot cannot get next to; resolves it
+    // when a single candidate is left
+    void filterReachable(GetCoordLocalResolver::Resolution& resolution) const {
+        if (!robot_pose.valid || resolution.candidates.size() < 2) {
+            return;
+        }
+
+        std::vector<std::string> target_ids;
+        target_ids.reserve(resolution.candidates.size());
+        for (uint32_t index : resolution.candidates) {
+            target_ids.emplace_back(map_state->items.id(index));
+        }
+        GetCoordPathfindReturn::SearchMode mode = resolution.candidates.size() <= jump_point_max_targets
+            ? GetCoordPathfindReturn::SearchMode::JumpPoint
+            : GetCoordPathfindReturn::SearchMode::EightConnected;
+        json approaches = GetCoordPathfindReturn::processBatch(
+            map_state->layers.walkable, map_state->scaled_resolution, origin, map_state->items,
+            {{"x", robot_pose.x}, {"y", robot_pose.y}}, target_ids, mode
+        );
+
+        std::vector<uint32_t> reachable;
+        for (size_t i = 0; i < approaches.size() && i < resolution.candidates.size(); ++i) {
+            const json& approach = approaches[i];
+            if (approach.value("success", false) 
+                && approach.value("approach_distance", -1.0) <= approach_pose.max_standoff_m) {
+                reachable.push_back(resolution.candidates[i]);
+            }
+        }
+        std::cout << "Debug: " << reachable.size() << " of " << resolution.candidates.size() 
+                  << " matching items can be approached" << std::endl;
+        if (reachable.size() == 1) {
+            resolution.outcome = GetCoordLocalResolver::Outcome::Resolved;
+            resolution.reason = "it is the only one of " + std::to_string(resolution.candidates.size()) 
+                              + " matching items the robot can reach";
+            resolution.candidates = reachable;
+        }
+    }
+
+    // Yaw facing the centre of the result's target item from the chosen pixel, 0 when the
+    // target is not a known item
+    float approachAngle(const json& result) const {
+        if (!result.contains("target_id") || !result["target_id"].is_string() || !result.contains("coordinates")
+            || !result["coordinates"]["x"].is_number() || !result["coordinates"]["y"].is_number()) {
+            return 0.0f;
+        }
+        int target = map_state->items.find(result["target_id"].get<std::string>());
+        if (target < 0) {
+            return 0.0f;
+        }
+        cv::Rect box = itemBox(static_cast<uint32_t>(target));
+        cv::Point2f centre(box.x + (box.width - 1) * 0.5f, box.y + (box.height - 1) * 0.5f);
+        cv::Point pixel(static_cast<int>(result["coordinates"]["x"].get<double>()),
+                        static_cast<int>(result["coordinates"]["y"].get<double>()));
+        return GetCoordApproachPose::facing(pixel, centre);
+    }
+
+    // Answer the request without the LLM when the description fits exactly one item,
+    // in the same form as an LLM answer in object map pixels
+    std::optional<json> resolveLocally(const std::string& object_description) {
+        if (!local_resolver) {
+            return std::nullopt;
+        }
+
+        GetCoordLocalResolver::Resolution resolution = GetCoordLocalResolver::resolve(
+            object_description, map_state->tokens, map_state->spatial, robot_pose
+        );
+        if (resolution.outcome == GetCoordLocalResolver::Outcome::Ambiguous) {
+            filterReachable(resolution);
+        }
+        if (resolution.outcome != GetCoordLocalResolver::Outcome::Resolved) {
+            std::cout << "Debug: Local resolver defers to the LLM: " << resolution.reason << std::endl;
+            return std::nullopt;
+        }
+
+        uint32_t target = resolution.candidates.front();
+        std::string target_id(map_state->items.id(target));
+        std::optional<GetCoordApproachPose::Pose> approach = GetCoordApproachPose::solve(
+            map_state->layers, reachability_field, itemBox(target), map_state->scaled_resolution, approach_pose
+        );
+        if (!approach) {
+            std::cout << "Debug: Local resolver found " << target_id 
+                      << " but nothing reachable around it, asking the LLM" << std::endl;
+            return std::nullopt;
+        }
+
+        json result = {
+            {"success", "true"},
+            {"coordinates", {{"x", approach->pixel.x}, {"y", approach->pixel.y}}},
+            {"target_id", target_id},
+            {"error", "none"},
+            {"message", "Sending robot to " + target_id + " because " + resolution.reason},
+            {"resolved_by", "local"}
+        };
+        std::cout << "Debug: Resolved locally to " << target_id << " at (" << approach->pixel.x << ", " 
+                  << approach->pixel.y << "), standoff " << approach->standoff_m << " m: " 
+                  << resolution.reason << std::endl;
+        saveJson(result, "08_local_resolution.json");
+        return result;
+    }
+
+    // Ask the LLM for the object, returning its answer in object map pixels
+    json searchWithLLM(const std::string& object_description) {
+        std::cout << "Debug: Starting LLM coordinate search" << std::endl;
+        json result;
+        // Prepare request message with the description and the items around it
+        json request_msg = {
+            {"description", object_description}
+        };
+        std::vector<uint32_t> relevant_items = relevantItems(object_description);
+        if (!relevant_items.empty()) {
+            request_msg["objects"] = map_state->items.toJson(relevant_items).dump();
+        }
+
+        // Encode the object map as a data URL for AI processing
+        const EncodedRegion& encoded = encodedObjectMap(requestRegion(relevant_items));
+        const std::string& image_url = encoded.data;
+        const GetCoordRoiCrop::RoiView sent_view = encoded.view;
+        std::cout << "Debug: image_url length: " << image_url.length() << std::endl;
+        if (image_url.length() > 40) {
+            std::cout << "Debug: image_url preview: " << image_url.substr(0, 20) << "..." 
+                    << image_url.substr(image_url.length() - 20) << std::endl;
+        }
+
+        // Convert nlohmann::json to Json::Value
+        Json::Value json_request_msg;
+        Json::Reader reader;
+
+        // Convert request_msg
+        std::string request_msg_str = request_msg.dump();
+        std::cout << "Debug: request_msg_str: " << request_msg_str << std::endl;
+        
+        if (!reader.parse(request_msg_str, json_request_msg)) {
+            std::string parse_error = "Failed to parse request message to Json::Value";
+            std::cout << "Debug: " << parse_error << std::endl;
+            throw std::runtime_error(parse_error);
+        }
+        std::cout << "Debug: Successfully parsed request_msg to Json::Value" << std::endl;
+
+        // Get coordinates using AI
+        std::string assistant_reply;
+        if (COORDINATES_METHOD == "oneCoordSearch") {
+            std::cout << "Debug: Calling getcoord_search with request and base64 image data" << std::endl;
             
-            // Save the pixel coordinates to a JSON file
-            std::ofstream pixel_coords_file(output_dir + "/07_pixel_coordinates.json");
-            pixel_coords_file << pixel_coords.dump(4);
-            pixel_coords_file.close();
+            try {
+                // Call the getcoord_search method with the converted Json::Value objects
+                assistant_reply = llm_coordinator.getcoord_search(json_request_msg, image_url);
+                std::cout << "Debug: Received assistant reply" << std::endl;
+            } catch (const std::exception& e) {
+                std::string error_msg = "Error in getcoord_search: " + std::string(e.what());
+                std::cout << "Debug: " << error_msg << std::endl;
+                throw std::runtime_error(error_msg);
+            }
+        }
+
+        // Parse the response
+        try {
+            std::cout << "Debug: Assistant reply: " << assistant_reply << std::endl;
+            result = json::parse(assistant_reply);
+            std::cout << "Debug: Successfully parsed assistant reply" << std::endl;
+        } catch (const json::parse_error& e) {
+            std::string error_msg = "Failed to parse AI response: " + std::string(e.what());
+            std::cout << "Debug: " << error_msg << std::endl;
+            std::cout << "Debug: Response was: " << assistant_reply << std::endl;
+            throw std::runtime_error(error_msg);
+        }
+
+        // Save the AI result to a JSON file
+        saveJson(result, "08_ai_search_result.json");
+
+        // The LLM picked a pixel on the image it was sent, bring it back to the object map
+        result = GetCoordOriginCoordReturn::toMapPixels(result, sent_view);
+        std::cout << "Debug: Saved AI result to file" << std::endl;
+        return result;
+    }
+
+    // Only answers that name a pixel are worth reusing; errors and refusals are retried
+    static bool isDecision(const json& result) {
+        if (result.contains("error") && result["error"] != "none") {
+            return false;
+        }
+        return result.contains("coordinates") && result["coordinates"].contains("x") && result["coordinates"].contains("y")
+            && result["coordinates"]["x"].is_number() && result["coordinates"]["y"].is_number();
+    }
+
+public:
+    CoordinateFinder(const std::string& items_json_path, const std::string& output_directory, const std::string& map_yaml_path = "",
+                     std::shared_ptr<SharedRequestState> shared_state = nullptr) 
+        : items_json_path(items_json_path), map_yaml_path(map_yaml_path),
+          shared(shared_state ? std::move(shared_state) : std::make_shared<SharedRequestState>(decision_cache_settings)),
+          output_dir(output_directory) {
+        // Inputs are loaded lazily through the map cache on the first findCoordinates call
+        std::cout << "DEBUG CONSTRUCTOR: Items JSON: " << items_json_path << ", map YAML: " << map_yaml_path << std::endl;
+    }
+
+    // Run the map pipeline, encode the object map and open the LLM connection ahead of the first request
+    void warmup(const std::string& map_path, const json& robot_position = json()) {
+        prepareMap(map_path, robot_position);
+        encodedObjectMap(requestRegion({}));
+        llm_coordinator.initialize_connection();
+    }
+
+    // Modified findCoordinates to work with just object description
+    json findCoordinates(const std::string& map_path, const std::string& object_description, const json& robot_position = json()) {
+        
+        bool success_map_init = false;
+        // Declare these variables at the top of the function so they're accessible in all scopes
+        float scaled_resolution;
+        json result;
+        
+        try {
+            prepareMap(map_path, robot_position);
+            scaled_resolution = map_state->scaled_resolution;
 
             success_map_init = true;
         
@@ -420,9 +915,7 @@ public:
             };
             
             // Save the error to a file
-            std::ofstream error_file(output_dir + "/error_log.json");
-            error_file << error_response.dump(4);
-            error_file.close();
+            saveJson(error_response, "error_log.json");
             
             return error_response;
         }
@@ -431,79 +924,35 @@ public:
             
             try {
                 
-                std::cout << "Debug: Starting LLM coordinate search" << std::endl;
                 ////// GET COORDINATES USING LLM HERE //////
-                // Prepare request message with just the description
-                json request_msg = {
-                    {"description", object_description}
-                };
-
-                // Base64 encode the object map for AI processing
-                std::vector<uchar> buffer;
-                cv::imencode(".jpg", object_map, buffer);
-                std::cout << "Debug: Image encoded to buffer size: " << buffer.size() << std::endl;
-                
-                // Proper base64 encoding
-                std::string base64_data = base64_encode(buffer.data(), buffer.size());
-                std::cout << "Debug: base64_data length: " << base64_data.length() << std::endl;
-                if (base64_data.length() > 40) {
-                    std::cout << "Debug: base64_data preview: " << base64_data.substr(0, 20) << "..." 
-                            << base64_data.substr(base64_data.length() - 20) << std::endl;
-                }
-
-                // Convert nlohmann::json to Json::Value
-                Json::Value json_request_msg;
-                Json::Value json_encoded_map;
-                Json::Reader reader;
-
-                // Convert request_msg
-                std::string request_msg_str = request_msg.dump();
-                std::cout << "Debug: request_msg_str: " << request_msg_str << std::endl;
-                
-                if (!reader.parse(request_msg_str, json_request_msg)) {
-                    std::string parse_error = "Failed to parse request message to Json::Value";
-                    std::cout << "Debug: " << parse_error << std::endl;
-                    throw std::runtime_error(parse_error);
-                }
-                std::cout << "Debug: Successfully parsed request_msg to Json::Value" << std::endl;
-
-                // Correctly create a string JSON value 
-                json_encoded_map = Json::Value(base64_data);
-                std::cout << "Debug: Created Json::Value for encoded image" << std::endl;
-
-                // Get coordinates using AI
-                std::string assistant_reply;
-                if (COORDINATES_METHOD == "oneCoordSearch") {
-                    std::cout << "Debug: Calling getcoord_search with request and base64 image data" << std::endl;
-                    
-                    try {
-                        // Call the getcoord_search method with the converted Json::Value objects
-                        assistant_reply = llm_coordinator.getcoord_search(json_request_msg, json_encoded_map);
-                        std::cout << "Debug: Received assistant reply" << std::endl;
-                    } catch (const std::exception& e) {
-                        std::string error_msg = "Error in getcoord_search: " + std::string(e.what());
-                        std::cout << "Debug: " << error_msg << std::endl;
-                        throw std::runtime_error(error_msg);
+                // Unambiguous descriptions are resolved locally, repeated ones come from the
+                // decision cache, and only the rest go to the LLM
+                GetCoordDecisionCache::DecisionCache& decision_cache = shared->decision_cache;
+                if (auto local = resolveLocally(object_description)) {
+                    result = std::move(*local);
+                    ++shared->local;
+                } else {
+                    GetCoordDecisionCache::Key decision_key = decision_cache.makeKey(
+                        object_description, map_state->content_hash, robot_pose.valid, robot_pose.x, robot_pose.y
+                    );
+                    if (auto cached = decision_cache.lookup(decision_key)) {
+                        result = std::move(*cached);
+                        ++shared->cached;
+                        std::cout << "Debug: Reusing cached decision for \"" << object_description << "\"" << std::endl;
+                    } else {
+                        result = searchWithLLM(object_description);
+                        ++shared->llm;
+                        if (isDecision(result)) {
+                            decision_cache.store(decision_key, result);
+                        }
+                    }
+                    if (artifacts.mode() != get_coordinates::ArtifactSink::Mode::Off) {
+                        json decision_stats = decision_cache.describe();
+                        std::cout << "Debug: Decision cache: " << decision_stats.dump() << std::endl;
+                        saveJson(decision_stats, "08b_decision_cache.json");
                     }
                 }
-
-                // Parse the response
-                try {
-                    std::cout << "Debug: Assistant reply: " << assistant_reply << std::endl;
-                    result = json::parse(assistant_reply);
-                    std::cout << "Debug: Successfully parsed assistant reply" << std::endl;
-                } catch (const json::parse_error& e) {
-                    std::string error_msg = "Failed to parse AI response: " + std::string(e.what());
-                    std::cout << "Debug: " << error_msg << std::endl;
-                    std::cout << "Debug: Response was: " << assistant_reply << std::endl;
-                    throw std::runtime_error(error_msg);
-                }
-
-                // Save the AI result to a JSON file
-                std::ofstream ai_result_file(output_dir + "/08_ai_search_result.json");
-                ai_result_file << result.dump(4);
-                ai_result_file.close();
-                std::cout << "Debug: Saved AI result to file" << std::endl;
+                std::cout << "Debug: Request paths: " << shared->describePaths().dump() << std::endl;
                 ////// ------------------------------ //////
 
 
@@ -515,9 +964,7 @@ public:
                 };
                 
                 // Save the error to a file
-                std::ofstream error_file(output_dir + "/error_log.json");
-                error_file << error_response.dump(4);
-                error_file.close();
+                saveJson(error_response, "error_log.json");
                 
                 return error_response;
             }
@@ -542,21 +989,40 @@ public:
                     result["angle"] = 0.0;
                     
                     // Save the error result to a file
-                    std::ofstream error_file(output_dir + "/error_result.json");
-                    error_file << result.dump(4);
-                    error_file.close();
+                    saveJson(result, "error_result.json");
                     
                     return result;
                 }
                 
-                // Process 7: Generate new coordinates map
-                cv::Mat new_coords_map;
-                float angle_deg;
-                std::tie(new_coords_map, angle_deg) = GetCoordNewCoordmapGeneration::process(
-                    object_map, scaled_resolution, origin, result, items_data
-                );
-                saveImage(new_coords_map, "09_new_coords_map.png");
-                std::cout << "Debug: Generated new coordinates map" << std::endl;
+                // Move a blocked or unreachable pixel to the nearest valid cell before using it
+                if (!validateCoordinates(result)) {
+                    json error_response = {
+                        {"success", false},
+                        {"error", "InvalidCoordinates"},
+                        {"message", "The chosen point is " + result["validation"]["status"].get<std::string>() 
+                                    + " and no free, reachable cell is close to it"},
+                        {"validation", result["validation"]}
+                    };
+                    saveJson(error_response, "error_result.json");
+                    return error_response;
+                }
+
+                // Reachability of the chosen pixel is a lookup in the cached distance field
+                annotateReachability(result);
+
+                // The robot faces the centre of the target item from the chosen pixel
+                float angle_deg = approachAngle(result);
+                std::cout << "Debug: Approach angle: " << angle_deg << " deg" << std::endl;
+
+                // Process 7: Generate new coordinates map. It is a debug render on a copy of
+                // the object map, so it is skipped when artifacts are off
+                if (artifacts.mode() != get_coordinates::ArtifactSink::Mode::Off) {
+                    cv::Mat new_coords_map = GetCoordNewCoordmapGeneration::process(
+                        object_map, scaled_resolution, origin, result, map_state->items, angle_deg
+                    );
+                    saveImage(new_coords_map, "09_new_coords_map.png");
+                    std::cout << "Debug: Generated new coordinates map" << std::endl;
+                }
             
                 // Process 8: Get origin coordinates
                 json origin_coords = GetCoordOriginCoordReturn::process(
@@ -568,10 +1034,12 @@ public:
                 std::cout << "Debug: Origin coords structure: " << origin_coords.dump() << std::endl;
                 
                 // Save the final coordinates to a JSON file
-                std::ofstream final_coords_file(output_dir + "/10_final_coordinates.json");
-                final_coords_file << origin_coords.dump(4);
-                final_coords_file.close();
+                saveJson(origin_coords, "10_final_coordinates.json");
                 std::cout << "Debug: Saved final coordinates to file" << std::endl;
+                auto artifact_stats = artifacts.stats();
+                std::cout << "Debug: Artifacts written: " << artifact_stats.written 
+                          << ", dropped: " << artifact_stats.dropped 
+                          << ", failed: " << artifact_stats.failed << std::endl;
             
                 return origin_coords;
 
@@ -583,9 +1051,7 @@ public:
                 };
                 
                 // Save the error to a file
-                std::ofstream error_file(output_dir + "/error_log.json");
-                error_file << error_response.dump(4);
-                error_file.close();
+                saveJson(error_response, "error_log.json");
                 
                 return error_response;
             }
@@ -598,9 +1064,7 @@ public:
             };
             
             // Save the error to a file
-            std::ofstream error_file(output_dir + "/error_log.json");
-            error_file << error_response.dump(4);
-            error_file.close();
+            saveJson(error_response, "error_log.json");
             
             return error_response;
         }
@@ -608,6 +1072,147 @@ public:
 };
 
 
+// Process-lifetime coordinate finders, so the LLM clients and encoded maps survive between requests.
+// Each request leases an idle finder (or a new one) and runs on it without holding any lock; the
+// map state itself is shared through the map cache. The mutex only guards the pool.
+static constexpr size_t MAX_POOLED_FINDERS = 4;
+static std::mutex finder_pool_mutex;
+static std::condition_variable finder_returned;
+static std::vector<std::unique_ptr<CoordinateFinder>> idle_finders;
+static std::string finder_pool_key;
+// Decision cache and request counters of the current pool, shared by its finders
+static std::shared_ptr<SharedRequestState> pool_shared_state;
+static uint64_t finder_pool_generation = 0;
+// Finders of the current pool, idle or leased
+static size_t finder_pool_size = 0;
+
+// A finder used by one request at a time, handed back to the pool when done. At most
+// MAX_POOLED_FINDERS exist per pool; further requests wait for one to come back.
+class FinderLease {
+public:
+    FinderLease(const std::string& items_json_path, const std::string& map_yaml_path, const std::string& output_dir) {
+        std::string key = items_json_path + "|" + map_yaml_path + "|" + output_dir;
+        std::vector<std::unique_ptr<CoordinateFinder>> evicted;
+        std::shared_ptr<SharedRequestState> shared_state;
+        size_t slot = 0;
+        {
+            std::unique_lock<std::mutex> lock(finder_pool_mutex);
+            while (true) {
+                // Finders on other inputs are never reused; they are destroyed once the lock is released
+                if (finder_pool_key != key || !pool_shared_state) {
+                    std::move(idle_finders.begin(), idle_finders.end(), std::back_inserter(evicted));
+                    idle_finders.clear();
+                    pool_shared_state = std::make_shared<SharedRequestState>(CoordinateFinder::decision_cache_settings);
+                    finder_pool_key = key;
+                    finder_pool_size = 0;
+                    ++finder_pool_generation;
+                }
+                generation = finder_pool_generation;
+                if (!idle_finders.empty()) {
+                    finder = std::move(idle_finders.back());
+                    idle_finders.pop_back();
+                    return;
+                }
+                if (finder_pool_size < MAX_POOLED_FINDERS) {
+                    slot = finder_pool_size++;
+                    shared_state = pool_shared_state;
+                    break;
+                }
+                finder_returned.wait(lock);
+            }
+        }
+
+        try {
+            finder = std::make_unique<CoordinateFinder>(items_json_path, slotDirectory(output_dir, slot), map_yaml_path,
+                                                        std::move(shared_state));
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(finder_pool_mutex);
+                if (generation == finder_pool_generation) {
+                    --finder_pool_size;
+                }
+            }
+            finder_returned.notify_one();
+            throw;
+        }
+    }
+
+    ~FinderLease() {
+        std::unique_ptr<CoordinateFinder> stale;
+        {
+            std::lock_guard<std::mutex> lock(finder_pool_mutex);
+            if (generation == finder_pool_generation) {
+                idle_finders.push_back(std::move(finder));
+            } else {
+                stale = std::move(finder);
+            }
+        }
+        finder_returned.notify_one();
+    }
+
+    FinderLease(const FinderLease&) = delete;
+    FinderLease& operator=(const FinderLease&) = delete;
+
+    CoordinateFinder& operator*() {
+        return *finder;
+    }
+
+private:
+    // The first finder writes its debug files to output_dir, concurrent ones to their own
+    // subdirectory so that no two requests write the same file at once
+    static std::string slotDirectory(const std::string& output_dir, size_t slot) {
+        if (slot == 0) {
+            return output_dir;
+        }
+        std::filesystem::path dir = std::filesystem::path(output_dir) / ("finder_" + std::to_string(slot));
+        std::filesystem::create_directories(dir);
+        return dir.string();
+    }
+
+    uint64_t generation = 0;
+    std::unique_ptr<CoordinateFinder> finder;
+};
+
+bool warmupCoordinates(
+    const std::string& map_path,
+    const std::string& items_json_path,
+    const std::string& map_yaml_path,
+    const std::string& output_dir,
+    const json& robot_position
+) {
+    try {
+        // The warmed finder goes back to the pool for the first request
+        FinderLease finder(items_json_path, map_yaml_path, output_dir);
+        (*finder).warmup(map_path, robot_position);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Warmup failed: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Shared state of the current pool, nullptr before the first request
+static std::shared_ptr<SharedRequestState> poolSharedState() {
+    std::lock_guard<std::mutex> lock(finder_pool_mutex);
+    return pool_shared_state;
+}
+
+json decisionCacheStats() {
+    std::shared_ptr<SharedRequestState> shared_state = poolSharedState();
+    if (!shared_state) {
+        return GetCoordDecisionCache::DecisionCache().describe();
+    }
+    return shared_state->decision_cache.describe();
+}
+
+json requestPathStats() {
+    std::shared_ptr<SharedRequestState> shared_state = poolSharedState();
+    if (!shared_state) {
+        return {{"local", 0}, {"decision_cache", 0}, {"llm", 0}, {"local_rate", 0.0}};
+    }
+    return shared_state->describePaths();
+}
+
 json findCoordinates(
     const std::string& map_path,
     const std::string& items_json_path,
@@ -617,11 +1222,11 @@ json findCoordinates(
     const json& robot_position
 ) {
     try {
-        // Initialize coordinate finder
-        CoordinateFinder finder(items_json_path, output_dir, map_yaml_path);
+        // Reuse an idle coordinate finder, or start one next to those busy with other requests
+        FinderLease finder(items_json_path, map_yaml_path, output_dir);
 
         // Find coordinates for the object using just the description
-        return finder.findCoordinates(
+        return (*finder).findCoordinates(
             map_path,           // Map image path
             object_description, // Object description
             robot_position      // Robot position
@@ -0,0 +1,93 @@
+#include "get_coordinates/getcoord_approach_pose.hpp"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace GetCoordApproachPose {
+    float facing(const cv::Point& from, const cv::Point2f& target) {
+        // Image rows grow downwards, world y grows upwards
+        double dx = target.x - from.x;
+        double dy = from.y - target.y;
+        if (dx == 0.0 && dy == 0.0) {
+            return 0.0f;
+        }
+        return static_cast<float>(std::atan2(dy, dx) * 180.0 / CV_PI);
+    }
+
+    std::optional<Pose> solve(const GetCoordMapLayers::MapLayers& layers,
+                              const GetCoordNonTraversableGeneration::ReachabilityField& field,
+                              const cv::Rect& item_box,
+                              double resolution,
+                              const Settings& settings) {
+        if (item_box.empty() || resolution <= 0.0 || settings.samples <= 0 || layers.cost.empty()) {
+            return std::nullopt;
+        }
+
+        // Box centre and half extents, pixel centres of the border cells
+        cv::Point2f centre(item_box.x + (item_box.width - 1) * 0.5f, item_box.y + (item_box.height - 1) * 0.5f);
+        double half_w = item_box.width * 0.5;
+        double half_h = item_box.height * 0.5;
+
+        // Ray directions, shared by every ring, with the distance from the centre to the box edge
+        struct Ray {
+            double dx;
+            double dy;
+            double to_edge;
+        };
+        std::vector<Ray> rays(settings.samples);
+        for (int i = 0; i < settings.samples; ++i) {
+            double theta = 2.0 * CV_PI * i / settings.samples;
+            Ray& ray = rays[i];
+            ray.dx = std::cos(theta);
+            ray.dy = -std::sin(theta);
+            double tx = std::abs(ray.dx) > 1e-9 ? half_w / std::abs(ray.dx) : HUGE_VAL;
+            double ty = std::abs(ray.dy) > 1e-9 ? half_h / std::abs(ray.dy) : HUGE_VAL;
+            ray.to_edge = std::min(tx, ty);
+        }
+
+        auto usable = [&](int x, int y) {
+            if (x < 0 || y < 0 || x >= layers.cols() || y >= layers.rows()) {
+                return false;
+            }
+            if (item_box.contains(cv::Point(x, y)) || layers.itemIndexAt(x, y) >= 0) {
+                return false;
+            }
+            if (!layers.walkable.isWalkable(y, x)) {
+                return false;
+            }
+            return field.empty() || field.isReachable(x, y);
+        };
+
+        double step = std::max(settings.standoff_step_m, resolution);
+        for (double standoff = settings.min_standoff_m; standoff <= settings.max_standoff_m + 1e-9; standoff += step) {
+            double standoff_px = standoff / resolution;
+            cv::Point best(-1, -1);
+            int32_t best_steps = INT32_MAX;
+            for (const Ray& ray : rays) {
+                double t = ray.to_edge + standoff_px;
+                cv::Point p(static_cast<int>(std::lround(centre.x + ray.dx * t)),
+                            static_cast<int>(std::lround(centre.y + ray.dy * t)));
+                if (!usable(p.x, p.y)) {
+                    continue;
+                }
+                int32_t steps = field.empty() ? 0 : field.steps[static_cast<size_t>(p.y) * field.cols + p.x];
+                if (steps < best_steps) {
+                    best = p;
+                    best_steps = steps;
+                }
+            }
+
+            if (best.x >= 0) {
+                Pose pose;
+                pose.pixel = best;
+                pose.angle_deg = facing(best, centre);
+                pose.standoff_m = standoff;
+                pose.path_m = field.empty() ? -1.0 : field.distance(best.x, best.y);
+                return pose;
+            }
+        }
+        return std::nullopt;
+    }
+}
@@ -0,0 +1,147 @@
+#include "get_coordinates/getcoord_coord_validation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace GetCoordCoordValidation {
+    std::string toString(Status status) {
+        switch (status) {
+            case Status::Valid: return "valid";
+            case Status::OutsideMap: return "outside_map";
+            case Status::Obstacle: return "obstacle";
+            case Status::Inflation: return "inflation";
+            case Status::OnItem: return "on_item";
+            case Status::Unreachable: return "unreachable";
+        }
+        return "unknown";
+    }
+
+    // Free and clear of items; the walkability plane already has the item boxes blocked
+    static bool isFree(const GetCoordMapLayers::MapLayers& layers, int x, int y) {
+        return layers.walkable.isWalkable(y, x) && layers.itemIndexAt(x, y) < 0;
+    }
+
+    SnapField buildSnapField(const GetCoordMapLayers::MapLayers& layers) {
+        SnapField snap;
+        snap.rows = layers.rows();
+        snap.cols = layers.cols();
+        snap.nearest.assign(static_cast<size_t>(snap.rows) * snap.cols, -1);
+        if (snap.nearest.empty() || layers.walkable.empty()) {
+            return snap;
+        }
+
+        // 0 on valid cells, so the distance transform labels every cell with its nearest valid one
+        cv::Mat invalid(snap.rows, snap.cols, CV_8U);
+        int valid_count = 0;
+        for (int y = 0; y < snap.rows; ++y) {
+            uint8_t* row = invalid.ptr<uint8_t>(y);
+            for (int x = 0; x < snap.cols; ++x) {
+                bool valid = isFree(layers, x, y) && (layers.reachable.empty() || layers.reachable.isWalkable(y, x));
+                row[x] = valid ? 0 : 255;
+                valid_count += valid;
+            }
+        }
+        if (valid_count == 0) {
+            return snap;
+        }
+
+        cv::Mat distance;
+        cv::Mat labels;
+        cv::distanceTransform(invalid, distance, labels, cv::DIST_L2, cv::DIST_MASK_5, cv::DIST_LABEL_PIXEL);
+
+        // Label of each valid cell back to its position
+        std::vector<int32_t> cell_of_label(static_cast<size_t>(valid_count) + 1, -1);
+        for (int y = 0; y < snap.rows; ++y) {
+            const uint8_t* row = invalid.ptr<uint8_t>(y);
+            const int32_t* label_row = labels.ptr<int32_t>(y);
+            for (int x = 0; x < snap.cols; ++x) {
+                if (row[x] == 0) {
+                    cell_of_label[label_row[x]] = y * snap.cols + x;
+                }
+            }
+        }
+        for (int y = 0; y < snap.rows; ++y) {
+            const int32_t* label_row = labels.ptr<int32_t>(y);
+            int32_t* out = snap.nearest.data() + static_cast<size_t>(y) * snap.cols;
+            for (int x = 0; x < snap.cols; ++x) {
+                out[x] = cell_of_label[label_row[x]];
+            }
+        }
+        return snap;
+    }
+
+    // Nearest free cell the robot reaches within max_radius pixels, searched in growing square rings
+    static cv::Point nearestReachable(const GetCoordMapLayers::MapLayers& layers,
+                                      const GetCoordNonTraversableGeneration::ReachabilityField& field,
+                                      const cv::Point& center, int max_radius) {
+        cv::Point best(-1, -1);
+        double best_distance = std::numeric_limits<double>::infinity();
+
+        // Every cell on ring r is at least r away, so stop once r passes the best distance
+        for (int radius = 0; radius <= max_radius && radius <= best_distance; ++radius) {
+            for (int y = center.y - radius; y <= center.y + radius; ++y) {
+                if (y < 0 || y >= layers.rows()) continue;
+                const bool edge_row = (y == center.y - radius || y == center.y + radius);
+                const int step = edge_row ? 1 : 2 * radius;
+                for (int x = center.x - radius; x <= center.x + radius; x += step) {
+                    if (x < 0 || x >= layers.cols()) continue;
+                    if (!isFree(layers, x, y) || !field.isReachable(x, y)) continue;
+
+                    const double distance = std::hypot(x - center.x, y - center.y);
+                    if (distance <= max_radius && distance < best_distance) {
+                        best_distance = distance;
+                        best = cv::Point(x, y);
+                    }
+                }
+            }
+        }
+        return best;
+    }
+
+    Check validate(const GetCoordMapLayers::MapLayers& layers,
+                   const GetCoordNonTraversableGeneration::ReachabilityField& field,
+                   const SnapField& snap,
+                   const cv::Point& pixel,
+                   double resolution,
+                   double max_snap_m) {
+        Check check;
+        check.requested = pixel;
+
+        cv::Point inside(std::clamp(pixel.x, 0, std::max(0, snap.cols - 1)),
+                         std::clamp(pixel.y, 0, std::max(0, snap.rows - 1)));
+        if (inside != pixel || snap.empty()) {
+            check.status = Status::OutsideMap;
+        } else if (layers.itemIndexAt(pixel.x, pixel.y) >= 0) {
+            check.status = Status::OnItem;
+        } else if (layers.cost.at<uint8_t>(pixel.y, pixel.x) == 0) {
+            check.status = Status::Obstacle;
+        } else if (!layers.walkable.isWalkable(pixel.y, pixel.x)) {
+            check.status = Status::Inflation;
+        } else if (!field.empty() && !field.isReachable(pixel.x, pixel.y)) {
+            check.status = Status::Unreachable;
+        }
+
+        if (check.status == Status::Valid) {
+            check.snapped = pixel;
+            return check;
+        }
+        if (snap.empty()) {
+            return check;
+        }
+
+        int32_t cell = snap.nearest[static_cast<size_t>(inside.y) * snap.cols + inside.x];
+        cv::Point candidate(-1, -1);
+        if (cell >= 0) {
+            candidate = cv::Point(cell % snap.cols, cell / snap.cols);
+        }
+        if (!field.empty() && (candidate.x < 0 || !field.isReachable(candidate.x, candidate.y))) {
+            int max_radius = static_cast<int>(max_snap_m / resolution);
+            candidate = nearestReachable(layers, field, inside, max_radius);
+        }
+        if (candidate.x >= 0) {
+            check.snapped = candidate;
+            check.moved_m = cv::norm(check.snapped - pixel) * resolution;
+        }
+        return check;
+    }
+}
@@ -1,11 +1,11 @@
 #include "get_coordinates/getcoord_costmap_generation.hpp"
+#include "get_coordinates/getcoord_tiling.hpp"
 #include <cmath>
+#include <stdexcept>
 
 namespace GetCoordCostmapGeneration {
-    cv::Mat process(const cv::Mat& map_img, double resolution, double inflation_radius_m) {
-        // Convert inflation radius from meters to pixels
-        int inflation_radius_px = static_cast<int>(std::ceil(inflation_radius_m / resolution));
-
+    // Serial cost map kernel for one (sub)image
+    static cv::Mat processRegion(const cv::Mat& map_img, double resolution, double inflation_radius_m) {
         // Create masks for obstacles and free space
         cv::Mat obstacles, free_space;
         cv::compare(map_img, 0, obstacles, cv::CMP_EQ);
@@ -40,4 +40,65 @@ namespace GetCoordCostmapGeneration {
 
         return cost_map;
     }
-}
\ No newline at end of file
+
+    int haloPixels(double resolution, double inflation_radius_m) {
+        // Convert inflation radius from meters to pixels
+        int inflation_radius_px = static_cast<int>(std::ceil(inflation_radius_m / resolution));
+        // The 5x5 chamfer distance can follow a path slightly longer than its value
+        // (knight steps cost 2.1969 for 2.236 px), plus the 2 px mask border
+        return inflation_radius_px + inflation_radius_px / 32 + 2;
+    }
+
+    cv::Mat process(const cv::Mat& map_img, double resolution, double inflation_radius_m, int tile_size) {
+        if (tile_size <= 0 || (map_img.rows <= tile_size && map_img.cols <= tile_size)) {
+            return processRegion(map_img, resolution, inflation_radius_m);
+        }
+
+        // Every pixel within the inflation radius of a tile core is inside its padded region,
+        // so each core comes out identical to the serial result
+        cv::Mat cost_map(map_img.size(), CV_8U);
+        auto tiles = GetCoordTiling::makeTiles(map_img.size(), tile_size, haloPixels(resolution, inflation_radius_m));
+        GetCoordTiling::forEachTile(tiles, [&](const GetCoordTiling::Tile& tile) {
+            cv::Mat padded_cost = processRegion(map_img(tile.padded), resolution, inflation_radius_m);
+            cv::Rect core_in_padded(tile.core.tl() - tile.padded.tl(), tile.core.size());
+            padded_cost(core_in_padded).copyTo(cost_map(tile.core));
+        });
+
+        return cost_map;
+    }
+
+    cv::Rect update(cv::Mat& cost_map, const cv::Mat& map_img, const cv::Rect& dirty_rect,
+                    double resolution, double inflation_radius_m) {
+        if (cost_map.size() != map_img.size() || cost_map.type() != CV_8U) {
+            throw std::invalid_argument("Cost map does not match the map image");
+        }
+
+        cv::Rect bounds(0, 0, map_img.cols, map_img.rows);
+        cv::Rect dirty = dirty_rect & bounds;
+        if (dirty.empty()) {
+            return cv::Rect();
+        }
+
+        // Only cells within the halo of the edit can change, and recomputing those
+        // exactly needs another halo of input around them
+        int halo = haloPixels(resolution, inflation_radius_m);
+        cv::Rect affected = cv::Rect(dirty.x - halo, dirty.y - halo, dirty.width + 2 * halo, dirty.height + 2 * halo) & bounds;
+        cv::Rect source = cv::Rect(affected.x - halo, affected.y - halo, affected.width + 2 * halo, affected.height + 2 * halo) & bounds;
+
+        cv::Mat source_cost = processRegion(map_img(source), resolution, inflation_radius_m);
+        cv::Rect affected_in_source(affected.tl() - source.tl(), affected.size());
+        source_cost(affected_in_source).copyTo(cost_map(affected));
+
+        return affected;
+    }
+
+    cv::Rect changedRegion(const cv::Mat& before, const cv::Mat& after) {
+        if (before.size() != after.size() || before.type() != after.type()) {
+            return cv::Rect(0, 0, after.cols, after.rows);
+        }
+
+        cv::Mat difference;
+        cv::compare(before, after, difference, cv::CMP_NE);
+        return cv::boundingRect(difference);
+    }
+}
@@ -0,0 +1,251 @@
+#include "get_coordinates/getcoord_decision_cache.hpp"
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+namespace GetCoordDecisionCache {
+    // FNV-1a over a string
+    static uint64_t hashText(const std::string& text) {
+        uint64_t hash = 14695981039346656037ULL;
+        for (unsigned char c : text) {
+            hash ^= c;
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    static std::string toHex(uint64_t value) {
+        char buffer[17];
+        std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(value));
+        return buffer;
+    }
+
+    std::string normalizeDescription(const std::string& description) {
+        std::string normalized;
+        normalized.reserve(description.size());
+        bool pending_space = false;
+        for (unsigned char c : description) {
+            if (std::isalnum(c) || c == '_' || c == '-') {
+                if (pending_space && !normalized.empty()) {
+                    normalized.push_back(' ');
+                }
+                pending_space = false;
+                normalized.push_back(static_cast<char>(std::tolower(c)));
+            } else {
+                pending_space = true;
+            }
+        }
+        return normalized;
+    }
+
+    DecisionCache::DecisionCache(Settings settings) : config(std::move(settings)) {
+        if (config.capacity == 0) {
+            config.capacity = 1;
+        }
+    }
+
+    Key DecisionCache::makeKey(const std::string& description, uint64_t map_hash,
+                               bool robot_valid, double robot_x, double robot_y) const {
+        Key key;
+        key.map_hash = map_hash;
+        key.text = toHex(map_hash) + "|";
+        if (robot_valid && config.pose_quantum_m > 0.0) {
+            long cell_x = static_cast<long>(std::floor(robot_x / config.pose_quantum_m));
+            long cell_y = static_cast<long>(std::floor(robot_y / config.pose_quantum_m));
+            key.text += std::to_string(cell_x) + "," + std::to_string(cell_y);
+        } else if (robot_valid) {
+            key.text += std::to_string(robot_x) + "," + std::to_string(robot_y);
+        } else {
+            key.text += "-";
+        }
+        key.text += "|" + normalizeDescription(description);
+        key.hash = hashText(key.text);
+        return key;
+    }
+
+    bool DecisionCache::expired(Clock::time_point stored_at) const {
+        if (config.ttl_s <= 0.0) {
+            return false;
+        }
+        return std::chrono::duration<double>(Clock::now() - stored_at).count() > config.ttl_s;
+    }
+
+    std::optional<nlohmann::json> DecisionCache::lookup(const Key& key) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto it = index.find(key.text);
+        if (it != index.end()) {
+            if (!expired(it->second->stored_at)) {
+                entries.splice(entries.begin(), entries, it->second);
+                ++counters.hits;
+                return it->second->decision;
+            }
+            entries.erase(it->second);
+            index.erase(it);
+            ++counters.expired;
+        }
+
+        if (!config.disk_dir.empty()) {
+            std::optional<Entry> entry = loadFromDisk(key);
+            if (entry) {
+                nlohmann::json decision = entry->decision;
+                insert(std::move(*entry));
+                ++counters.disk_hits;
+                return decision;
+            }
+        }
+
+        ++counters.misses;
+        return std::nullopt;
+    }
+
+    void DecisionCache::store(const Key& key, const nlohmann::json& decision) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        Entry entry{key.text, key.map_hash, Clock::now(), decision};
+        if (!config.disk_dir.empty()) {
+            saveToDisk(key, entry);
+        }
+        insert(std::move(entry));
+        ++counters.stores;
+    }
+
+    void DecisionCache::insert(Entry entry) {
+        auto it = index.find(entry.text);
+        if (it != index.end()) {
+            entries.erase(it->second);
+            index.erase(it);
+        }
+        entries.push_front(std::move(entry));
+        index[entries.front().text] = entries.begin();
+
+        while (entries.size() > config.capacity) {
+            index.erase(entries.back().text);
+            entries.pop_back();
+            ++counters.evictions;
+        }
+    }
+
+    void DecisionCache::invalidateMap(uint64_t map_hash) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        size_t dropped = 0;
+        for (auto it = entries.begin(); it != entries.end();) {
+            if (it->map_hash == map_hash) {
+                index.erase(it->text);
+                it = entries.erase(it);
+                ++dropped;
+            } else {
+                ++it;
+            }
+        }
+
+        if (!config.disk_dir.empty()) {
+            std::error_code ec;
+            fs::remove_all(fs::path(config.disk_dir) / toHex(map_hash), ec);
+        }
+        std::cout << "Decision cache: dropped " << dropped << " decisions of map " << toHex(map_hash) << std::endl;
+    }
+
+    void DecisionCache::clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        entries.clear();
+        index.clear();
+        if (!config.disk_dir.empty()) {
+            std::error_code ec;
+            for (const auto& map_dir : fs::directory_iterator(config.disk_dir, ec)) {
+                fs::remove_all(map_dir.path(), ec);
+            }
+        }
+    }
+
+    Stats DecisionCache::stats() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        Stats result = counters;
+        result.entries = entries.size();
+        return result;
+    }
+
+    nlohmann::json DecisionCache::describe() const {
+        Stats s = stats();
+        return {
+            {"hits", s.hits},
+            {"disk_hits", s.disk_hits},
+            {"misses", s.misses},
+            {"stores", s.stores},
+            {"evictions", s.evictions},
+            {"expired", s.expired},
+            {"entries", s.entries},
+            {"hit_rate", s.hitRate()}
+        };
+    }
+
+    std::string DecisionCache::diskPath(const Key& key) const {
+        return (fs::path(config.disk_dir) / toHex(key.map_hash) / (toHex(key.hash) + ".json")).string();
+    }
+
+    std::optional<DecisionCache::Entry> DecisionCache::loadFromDisk(const Key& key) {
+        std::string path = diskPath(key);
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            return std::nullopt;
+        }
+
+        try {
+            nlohmann::json stored = nlohmann::json::parse(file);
+            // The file name is only a hash, the full key tells colliding requests apart
+            if (stored.value("key", "") != key.text) {
+                return std::nullopt;
+            }
+            Clock::time_point stored_at{std::chrono::seconds(stored.at("stored_at").get<int64_t>())};
+            if (expired(stored_at)) {
+                ++counters.expired;
+                file.close();
+                std::error_code ec;
+                fs::remove(path, ec);
+                return std::nullopt;
+            }
+            return Entry{key.text, key.map_hash, stored_at, stored.at("decision")};
+        } catch (const nlohmann::json::exception& e) {
+            std::cerr << "Decision cache: ignoring unreadable " << path << ": " << e.what() << std::endl;
+            return std::nullopt;
+        }
+    }
+
+    void DecisionCache::saveToDisk(const Key& key, const Entry& entry) {
+        std::string path = diskPath(key);
+        std::error_code ec;
+        fs::create_directories(fs::path(path).parent_path(), ec);
+        if (ec) {
+            std::cerr << "Decision cache: cannot create " << fs::path(path).parent_path() << ": " << ec.message() << std::endl;
+            return;
+        }
+
+        nlohmann::json stored = {
+            {"key", entry.text},
+            {"stored_at", std::chrono::duration_cast<std::chrono::seconds>(entry.stored_at.time_since_epoch()).count()},
+            {"decision", entry.decision}
+        };
+
+        // Written next to the target and renamed, so a reader never sees a partial file
+        std::string tmp_path = path + ".tmp";
+        {
+            std::ofstream file(tmp_path, std::ios::trunc);
+            file << stored.dump();
+            if (!file) {
+                std::cerr << "Decision cache: failed to write " << tmp_path << std::endl;
+                return;
+            }
+        }
+        fs::rename(tmp_path, path, ec);
+        if (ec) {
+            std::cerr << "Decision cache: failed to store " << path << ": " << ec.message() << std::endl;
+        }
+    }
+}
@@ -1,65 +1,78 @@
 #include "get_coordinates/getcoord_grid_generation.hpp"
+#include "get_coordinates/getcoord_tiling.hpp"
 #include <vector>
 
 namespace GetCoordGridGeneration {
-    cv::Mat process(const cv::Mat& cost_map, double resolution, int grid_scale) {
-        // Calculate pixels per grid cell
-        int pixels_per_grid_cell = grid_scale;
-
-        // Map dimensions
-        int height = cost_map.rows;
-        int width = cost_map.cols;
-
+    cv::Mat process(const cv::Mat& cost_map, double resolution, int grid_scale, int band_rows) {
         // Create a copy of the map to draw the grid on
-        cv::Mat grid_map = cost_map.clone();
-
-        // Ensure cost_map is in correct format
-        cv::Mat cost_map_gray;
-        if (grid_map.channels() == 1) {
-            cv::cvtColor(grid_map, grid_map, cv::COLOR_GRAY2BGR);
-        }
-
-        // Ensure we have a proper grayscale version for analysis
-        if (cost_map.channels() == 3) {
-            cv::cvtColor(cost_map, cost_map_gray, cv::COLOR_BGR2GRAY);
+        cv::Mat grid_map;
+        if (cost_map.channels() == 1) {
+            cv::cvtColor(cost_map, grid_map, cv::COLOR_GRAY2BGR);
         } else {
-            cost_map_gray = cost_map.clone();
+            grid_map = cost_map.clone();
         }
 
-        // Threshold to binary
-        cv::Mat binary_map;
-        cv::threshold(cost_map_gray, binary_map, 254, 255, cv::THRESH_BINARY);
+        drawInPlace(grid_map, grid_scale, band_rows);
+        return grid_map;
+    }
+
+    void drawInPlace(cv::Mat& grid_map, int grid_scale, int band_rows) {
+        // Calculate pixels per grid cell
+        int pixels_per_grid_cell = grid_scale;
+
+        // Map dimensions
+        int height = grid_map.rows;
+        int width = grid_map.cols;
 
         // Generate x positions for vertical grid lines
         std::vector<int> x_positions;
         for (int x = 0; x < width; x += pixels_per_grid_cell) {
             x_positions.push_back(x);
         }
+        const int line_count = static_cast<int>(x_positions.size());
+
+        // A line pixel is painted where the map is white in grayscale (threshold at 254).
+        // Only line pixels are converted, with cvtColor so the rounding matches a full
+        // conversion. Each band only touches its own rows, so the result does not depend
+        // on the band size
+        GetCoordTiling::forEachRowBand(height, band_rows, [&](int row_begin, int row_end) {
+            int rows = row_end - row_begin;
 
-        // Draw vertical grid lines
-        for (int x : x_positions) {
-            for (int y = 0; y < height; y++) {
-                if (binary_map.at<uchar>(y, x) == 255) {
-                    grid_map.at<cv::Vec3b>(y, x) = cv::Vec3b(0, 0, 255);
+            // Gather the vertical line columns of this band and convert them together
+            cv::Mat columns(rows, line_count, CV_8UC3);
+            for (int y = row_begin; y < row_end; y++) {
+                const cv::Vec3b* grid_row = grid_map.ptr<cv::Vec3b>(y);
+                cv::Vec3b* column_row = columns.ptr<cv::Vec3b>(y - row_begin);
+                for (int i = 0; i < line_count; i++) {
+                    column_row[i] = grid_row[x_positions[i]];
                 }
             }
-        }
+            cv::Mat columns_gray;
+            cv::cvtColor(columns, columns_gray, cv::COLOR_BGR2GRAY);
 
-        // Generate y positions for horizontal grid lines
-        std::vector<int> y_positions;
-        for (int y = 0; y < height; y += pixels_per_grid_cell) {
-            y_positions.push_back(y);
-        }
+            cv::Mat row_gray;
+            for (int y = row_begin; y < row_end; y++) {
+                cv::Vec3b* grid_row = grid_map.ptr<cv::Vec3b>(y);
 
-        // Draw horizontal grid lines
-        for (int y : y_positions) {
-            for (int x = 0; x < width; x++) {
-                if (binary_map.at<uchar>(y, x) == 255) {
-                    grid_map.at<cv::Vec3b>(y, x) = cv::Vec3b(0, 0, 255);
+                if (y % pixels_per_grid_cell == 0) {
+                    // Draw horizontal grid line
+                    cv::cvtColor(grid_map.row(y), row_gray, cv::COLOR_BGR2GRAY);
+                    const uchar* gray = row_gray.ptr<uchar>(0);
+                    for (int x = 0; x < width; x++) {
+                        if (gray[x] > 254) {
+                            grid_row[x] = cv::Vec3b(0, 0, 255);
+                        }
+                    }
+                } else {
+                    // Draw vertical grid lines
+                    const uchar* gray = columns_gray.ptr<uchar>(y - row_begin);
+                    for (int i = 0; i < line_count; i++) {
+                        if (gray[i] > 254) {
+                            grid_row[x_positions[i]] = cv::Vec3b(0, 0, 255);
+                        }
+                    }
                 }
             }
-        }
-
-        return grid_map;
+        });
     }
-}
\ No newline at end of file
+}
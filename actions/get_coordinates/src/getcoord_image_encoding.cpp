@@ -0,0 +1,123 @@
+#include "get_coordinates/getcoord_image_encoding.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <stdexcept>
+
+namespace GetCoordImageEncoding {
+    // Quality decrement per attempt for lossy formats
+    static const int quality_step = 10;
+
+    static const char* extension(Format format) {
+        switch (format) {
+            case Format::Png: return ".png";
+            case Format::Webp: return ".webp";
+            default: return ".jpg";
+        }
+    }
+
+    static const char* formatName(Format format) {
+        switch (format) {
+            case Format::Png: return "png";
+            case Format::Webp: return "webp";
+            default: return "jpeg";
+        }
+    }
+
+    static bool isLossy(Format format) {
+        return format != Format::Png;
+    }
+
+    static std::vector<uchar> encodeOnce(const cv::Mat& image, Format format, int quality) {
+        std::vector<int> params;
+        if (format == Format::Jpeg) {
+            params = {cv::IMWRITE_JPEG_QUALITY, quality};
+        } else if (format == Format::Webp) {
+            params = {cv::IMWRITE_WEBP_QUALITY, quality};
+        }
+
+        std::vector<uchar> bytes;
+        if (!cv::imencode(extension(format), image, bytes, params)) {
+            throw std::runtime_error(std::string("Failed to encode image as ") + formatName(format));
+        }
+        return bytes;
+    }
+
+    const char* mimeType(Format format) {
+        switch (format) {
+            case Format::Png: return "image/png";
+            case Format::Webp: return "image/webp";
+            default: return "image/jpeg";
+        }
+    }
+
+    Format parseFormat(const std::string& name) {
+        std::string lower = name;
+        std::transform(lower.begin(), lower.end(), lower.begin(), 
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (lower == "jpeg" || lower == "jpg") return Format::Jpeg;
+        if (lower == "png") return Format::Png;
+        if (lower == "webp") return Format::Webp;
+        throw std::invalid_argument("Unknown image format: " + name);
+    }
+
+    EncodedImage encode(const cv::Mat& image, const Settings& settings) {
+        EncodedImage encoded;
+        encoded.format = settings.format;
+        encoded.quality = std::clamp(settings.quality, 1, 100);
+        int min_quality = std::clamp(settings.min_quality, 1, encoded.quality);
+        double min_scale = std::clamp(settings.min_scale, 0.01, 1.0);
+
+        // Pixel budget
+        double pixels = static_cast<double>(image.cols) * image.rows;
+        if (settings.max_pixels > 0 && pixels > settings.max_pixels) {
+            encoded.scale = std::sqrt(settings.max_pixels / pixels);
+        }
+
+        cv::Mat scaled;
+        double scaled_for = 0.0;
+        while (true) {
+            // Resize only when the scale changed since the last attempt
+            if (encoded.scale < 1.0 && encoded.scale != scaled_for) {
+                cv::Size size(std::max(1, static_cast<int>(image.cols * encoded.scale)),
+                              std::max(1, static_cast<int>(image.rows * encoded.scale)));
+                cv::resize(image, scaled, size, 0, 0, cv::INTER_AREA);
+                scaled_for = encoded.scale;
+            }
+            const cv::Mat& source = encoded.scale < 1.0 ? scaled : image;
+            encoded.size = source.size();
+            encoded.bytes = encodeOnce(source, encoded.format, encoded.quality);
+
+            if (settings.max_bytes == 0 || encoded.bytes.size() <= settings.max_bytes) {
+                encoded.within_budget = true;
+                return encoded;
+            }
+
+            // Cheapest fix first: lower the quality of lossy formats
+            if (isLossy(encoded.format) && encoded.quality > min_quality) {
+                encoded.quality = std::max(min_quality, encoded.quality - quality_step);
+                continue;
+            }
+
+            // Then shrink the image, estimating bytes as proportional to the pixel count
+            if (encoded.scale <= min_scale) {
+                encoded.within_budget = false;
+                return encoded;
+            }
+            double ratio = std::sqrt(static_cast<double>(settings.max_bytes) / encoded.bytes.size());
+            encoded.scale = std::max(min_scale, encoded.scale * std::min(ratio, 0.9));
+        }
+    }
+
+    nlohmann::json describe(const EncodedImage& encoded) {
+        return {
+            {"format", formatName(encoded.format)},
+            {"quality", encoded.quality},
+            {"scale", encoded.scale},
+            {"width", encoded.size.width},
+            {"height", encoded.size.height},
+            {"bytes", encoded.bytes.size()},
+            {"within_budget", encoded.within_budget}
+        };
+    }
+}
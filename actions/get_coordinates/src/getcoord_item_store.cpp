@@ -0,0 +1,93 @@
+#include "get_coordinates/getcoord_item_store.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace GetCoordItemStore {
+    ItemStore ItemStore::fromJson(const nlohmann::json& items_data) {
+        ItemStore store;
+
+        // Class table, keeping the order of the "classes" list
+        std::unordered_map<std::string, uint16_t> class_lookup;
+        auto classIndex = [&](const std::string& class_name) {
+            auto it = class_lookup.find(class_name);
+            if (it != class_lookup.end()) {
+                return it->second;
+            }
+            if (store.class_names.size() > 65535) {
+                throw std::runtime_error("Too many item classes");
+            }
+            uint16_t index = static_cast<uint16_t>(store.class_names.size());
+            store.class_names.push_back(class_name);
+            class_lookup.emplace(class_name, index);
+            return index;
+        };
+        if (items_data.contains("classes")) {
+            for (const auto& class_name : items_data["classes"]) {
+                classIndex(class_name.get<std::string>());
+            }
+        }
+
+        for (const auto& [item_class, items_list] : items_data["items"].items()) {
+            uint16_t class_index = classIndex(item_class);
+            for (const auto& item : items_list) {
+                uint32_t index = static_cast<uint32_t>(store.size());
+                std::string item_id = item["id"];
+
+                store.id_spans.push_back(store.append(item_id));
+                store.description_spans.push_back(store.append(item.value("description", "")));
+                store.class_indices.push_back(class_index);
+                store.xs.push_back(item["coordinates"]["x"].get<double>());
+                store.ys.push_back(item["coordinates"]["y"].get<double>());
+                store.widths.push_back(item["dimensions"]["width"].get<double>());
+                store.heights.push_back(item["dimensions"]["height"].get<double>());
+
+                store.by_id.emplace(item_id, index);
+                store.by_class[item_class].push_back(index);
+            }
+        }
+
+        return store;
+    }
+
+    int ItemStore::find(const std::string& item_id) const {
+        auto it = by_id.find(item_id);
+        return it == by_id.end() ? -1 : static_cast<int>(it->second);
+    }
+
+    const std::vector<uint32_t>& ItemStore::ofClass(const std::string& class_name) const {
+        static const std::vector<uint32_t> none;
+        auto it = by_class.find(class_name);
+        return it == by_class.end() ? none : it->second;
+    }
+
+    nlohmann::json ItemStore::toJson(std::vector<uint32_t> indices) const {
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+        nlohmann::json items_data;
+        items_data["classes"] = nlohmann::json::array();
+        items_data["items"] = nlohmann::json::object();
+        for (uint32_t index : indices) {
+            const std::string& item_class = className(index);
+            if (!items_data["items"].contains(item_class)) {
+                items_data["classes"].push_back(item_class);
+                items_data["items"][item_class] = nlohmann::json::array();
+            }
+            items_data["items"][item_class].push_back({
+                {"id", id(index)},
+                {"description", description(index)},
+                {"coordinates", {{"x", x(index)}, {"y", y(index)}}},
+                {"dimensions", {{"height", height(index)}, {"width", width(index)}}}
+            });
+        }
+        return items_data;
+    }
+
+    ItemStore::Span ItemStore::append(const std::string& text) {
+        Span span;
+        span.offset = static_cast<uint32_t>(arena.size());
+        span.length = static_cast<uint32_t>(text.size());
+        arena += text;
+        return span;
+    }
+}
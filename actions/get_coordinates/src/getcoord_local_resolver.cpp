@@ -0,0 +1,201 @@
+#include "get_coordinates/getcoord_local_resolver.hpp"
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <string_view>
+#include <unordered_set>
+
+namespace GetCoordLocalResolver {
+    // Words that carry no information about the target
+    static const std::unordered_set<std::string> filler_words = {
+        "a", "an", "the", "to", "go", "goto", "move", "drive", "navigate", "head", "take", "bring",
+        "find", "please", "me", "my", "us", "our", "of", "at", "this", "that", "there", "object", "item"
+    };
+
+    // Words that relate the target to something else; only the LLM can judge these
+    static const std::unordered_set<std::string> relation_words = {
+        "next", "near", "beside", "besides", "behind", "left", "right", "between", "front", "by",
+        "under", "above", "below", "over", "opposite", "far", "close", "closer", "corner", "side",
+        "with", "without", "and", "or", "not", "other", "another", "second", "third", "last", "first",
+        "farthest", "furthest", "middle", "center", "centre", "facing", "around", "across", "from"
+    };
+
+    static const std::unordered_set<std::string> nearest_words = {"nearest", "closest"};
+
+    // Nearest candidates closer to each other than this are not told apart
+    static const double nearest_margin_m = 0.1;
+
+    // Lower case words of a text, split on anything but letters, digits and '_'
+    static std::vector<std::string> words(std::string_view text) {
+        std::vector<std::string> result;
+        std::string word;
+        for (unsigned char c : text) {
+            if (std::isalnum(c) || c == '_') {
+                word.push_back(static_cast<char>(std::tolower(c)));
+            } else if (!word.empty()) {
+                result.push_back(std::move(word));
+                word.clear();
+            }
+        }
+        if (!word.empty()) {
+            result.push_back(std::move(word));
+        }
+        return result;
+    }
+
+    static std::string lower(std::string_view text) {
+        std::string result(text);
+        std::transform(result.begin(), result.end(), result.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return result;
+    }
+
+    TokenIndex TokenIndex::build(const GetCoordItemStore::ItemStore& items) {
+        TokenIndex index;
+        for (uint32_t i = 0; i < items.size(); ++i) {
+            index.ids.emplace(lower(items.id(i)), i);
+
+            std::vector<std::string> item_words = words(items.className(i));
+            std::vector<std::string> description_words = words(items.description(i));
+            item_words.insert(item_words.end(), description_words.begin(), description_words.end());
+            for (const auto& word : item_words) {
+                std::vector<uint32_t>& posting = index.postings[word];
+                // Items are visited in order, so a posting only needs its last entry checked
+                if (posting.empty() || posting.back() != i) {
+                    posting.push_back(i);
+                }
+            }
+        }
+        return index;
+    }
+
+    int TokenIndex::findId(const std::string& word) const {
+        auto it = ids.find(word);
+        return it == ids.end() ? -1 : static_cast<int>(it->second);
+    }
+
+    const std::vector<uint32_t>* TokenIndex::find(const std::string& word) const {
+        auto it = postings.find(word);
+        if (it != postings.end()) {
+            return &it->second;
+        }
+        // Plural forms of indexed words
+        for (size_t suffix : {size_t(2), size_t(1)}) {
+            if (word.size() > suffix + 2) {
+                std::string_view ending = std::string_view(word).substr(word.size() - suffix);
+                if (ending == (suffix == 2 ? "es" : "s")) {
+                    it = postings.find(word.substr(0, word.size() - suffix));
+                    if (it != postings.end()) {
+                        return &it->second;
+                    }
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    Resolution resolve(const std::string& description,
+                       const TokenIndex& tokens,
+                       const GetCoordSpatialIndex::SpatialIndex& spatial,
+                       const GetCoordMapLayers::RobotPose& robot) {
+        Resolution resolution;
+
+        int named_id = -1;
+        bool nearest = false;
+        std::vector<uint32_t> candidates;
+        bool have_candidates = false;
+        for (const auto& word : words(description)) {
+            if (filler_words.count(word)) {
+                continue;
+            }
+            if (nearest_words.count(word)) {
+                nearest = true;
+                continue;
+            }
+            if (relation_words.count(word)) {
+                resolution.reason = "the description relates the target to something else ('" + word + "')";
+                return resolution;
+            }
+
+            int id = tokens.findId(word);
+            if (id >= 0) {
+                if (named_id >= 0 && named_id != id) {
+                    resolution.reason = "the description names several item ids";
+                    return resolution;
+                }
+                named_id = id;
+                continue;
+            }
+
+            const std::vector<uint32_t>* posting = tokens.find(word);
+            if (!posting) {
+                resolution.reason = "'" + word + "' does not occur in any item id, class or description";
+                return resolution;
+            }
+            // Items matching every word so far
+            if (!have_candidates) {
+                candidates = *posting;
+                have_candidates = true;
+            } else {
+                std::vector<uint32_t> both;
+                std::set_intersection(candidates.begin(), candidates.end(), posting->begin(), posting->end(),
+                                      std::back_inserter(both));
+                candidates = std::move(both);
+            }
+        }
+
+        // An id decides on its own, as long as the other words agree with it
+        if (named_id >= 0) {
+            uint32_t id = static_cast<uint32_t>(named_id);
+            if (have_candidates && !std::binary_search(candidates.begin(), candidates.end(), id)) {
+                resolution.reason = "the item id and the other words describe different items";
+                return resolution;
+            }
+            resolution.outcome = Outcome::Resolved;
+            resolution.candidates = {id};
+            resolution.reason = "the description names its id";
+            return resolution;
+        }
+
+        if (!have_candidates) {
+            resolution.reason = "the description names no item";
+            return resolution;
+        }
+        if (candidates.empty()) {
+            resolution.reason = "no single item matches every word of the description";
+            return resolution;
+        }
+        resolution.candidates = candidates;
+        if (candidates.size() == 1) {
+            resolution.outcome = Outcome::Resolved;
+            resolution.reason = "it is the only item matching the description";
+            return resolution;
+        }
+
+        // "nearest" picks the candidate closest to the robot when it is clearly closest
+        if (nearest && robot.valid) {
+            std::vector<std::pair<double, uint32_t>> by_distance;
+            by_distance.reserve(candidates.size());
+            for (uint32_t i : candidates) {
+                by_distance.emplace_back(spatial.distanceTo(i, robot.x, robot.y), i);
+            }
+            std::sort(by_distance.begin(), by_distance.end());
+            if (by_distance[1].first - by_distance[0].first > nearest_margin_m) {
+                resolution.outcome = Outcome::Resolved;
+                resolution.candidates.clear();
+                for (const auto& entry : by_distance) {
+                    resolution.candidates.push_back(entry.second);
+                }
+                resolution.reason = "it is the nearest of " + std::to_string(candidates.size()) + " matching items";
+                return resolution;
+            }
+            resolution.outcome = Outcome::Ambiguous;
+            resolution.reason = "the nearest matching items are equally close";
+            return resolution;
+        }
+
+        resolution.outcome = Outcome::Ambiguous;
+        resolution.reason = std::to_string(candidates.size()) + " items match the description";
+        return resolution;
+    }
+}
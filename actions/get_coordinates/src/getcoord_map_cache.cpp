@@ -0,0 +1,209 @@
+#include "get_coordinates/getcoord_map_cache.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace GetCoordMapCache {
+    namespace {
+        struct FileFingerprint {
+            std::string path;
+            bool exists = false;
+            fs::file_time_type mtime;
+            std::uintmax_t size = 0;
+            uint64_t content_hash = 0;
+        };
+
+        struct CacheEntry {
+            std::vector<FileFingerprint> files;
+            PipelineParams params;
+            std::shared_ptr<const MapState> state;
+        };
+
+        struct CacheSlot {
+            CacheEntry entry;                       // state is null until the first build finishes
+            std::shared_future<void> building;      // Valid while a build of these inputs is running
+        };
+
+        // Guards the slots only; files are hashed and states built without it
+        std::mutex cache_mutex;
+        std::unordered_map<std::string, CacheSlot> cache;
+        uint64_t next_version = 1;
+
+        // FNV-1a over the whole file
+        uint64_t hashFile(const std::string& path) {
+            uint64_t hash = 14695981039346656037ULL;
+            std::ifstream file(path, std::ios::binary);
+            std::vector<char> buffer(1 << 16);
+            while (file) {
+                file.read(buffer.data(), buffer.size());
+                std::streamsize count = file.gcount();
+                for (std::streamsize i = 0; i < count; ++i) {
+                    hash ^= static_cast<unsigned char>(buffer[i]);
+                    hash *= 1099511628211ULL;
+                }
+            }
+            return hash;
+        }
+
+        FileFingerprint fingerprint(const std::string& path) {
+            FileFingerprint fp;
+            fp.path = path;
+            std::error_code ec;
+            fp.exists = !path.empty() && fs::exists(path, ec);
+            if (fp.exists) {
+                fp.mtime = fs::last_write_time(path, ec);
+                fp.size = fs::file_size(path, ec);
+                fp.content_hash = hashFile(path);
+            }
+            return fp;
+        }
+
+        // FNV-1a over the file contents and the parameters the state was built with
+        uint64_t contentHash(const std::vector<FileFingerprint>& files, const PipelineParams& params) {
+            uint64_t hash = 14695981039346656037ULL;
+            auto mix = [&hash](uint64_t value) {
+                for (int i = 0; i < 8; ++i) {
+                    hash ^= (value >> (8 * i)) & 0xff;
+                    hash *= 1099511628211ULL;
+                }
+            };
+            for (const auto& file : files) {
+                mix(file.exists);
+                mix(file.content_hash);
+            }
+            uint32_t inflation_bits;
+            std::memcpy(&inflation_bits, &params.inflation_radius_m, sizeof(inflation_bits));
+            mix(inflation_bits);
+            mix(static_cast<uint64_t>(params.scale_factor));
+            mix(static_cast<uint64_t>(params.grid_scale));
+            return hash;
+        }
+
+        // Check a cached fingerprint against the file on disk, refreshing the
+        // stored mtime when only the timestamp moved
+        bool unchanged(FileFingerprint& cached) {
+            std::error_code ec;
+            bool exists = !cached.path.empty() && fs::exists(cached.path, ec);
+            if (exists != cached.exists) {
+                return false;
+            }
+            if (!exists) {
+                return true;
+            }
+
+            fs::file_time_type mtime = fs::last_write_time(cached.path, ec);
+            std::uintmax_t size = fs::file_size(cached.path, ec);
+            if (mtime == cached.mtime && size == cached.size) {
+                return true;
+            }
+
+            if (size != cached.size || hashFile(cached.path) != cached.content_hash) {
+                return false;
+            }
+
+            cached.mtime = mtime;
+            return true;
+        }
+    }
+
+    std::shared_ptr<const MapState> acquire(const std::string& map_path,
+                                            const std::string& items_json_path,
+                                            const std::string& map_yaml_path,
+                                            const PipelineParams& params,
+                                            const Builder& build) {
+        std::string key = map_path + "|" + items_json_path + "|" + map_yaml_path;
+        while (true) {
+            std::unique_lock<std::mutex> lock(cache_mutex);
+            CacheSlot& slot = cache[key];
+            if (slot.building.valid()) {
+                // Another caller is building these inputs, wait for it and check its result
+                std::shared_future<void> building = slot.building;
+                lock.unlock();
+                building.wait();
+                continue;
+            }
+            CacheEntry cached = slot.entry;
+            lock.unlock();
+
+            // Compare against the files outside the lock, hashing may read the whole map
+            if (cached.state && cached.params == params) {
+                bool valid = true;
+                for (auto& file : cached.files) {
+                    if (!unchanged(file)) {
+                        std::cout << "Map cache: " << file.path << " changed, rebuilding" << std::endl;
+                        valid = false;
+                        break;
+                    }
+                }
+                if (valid) {
+                    lock.lock();
+                    if (slot.entry.state == cached.state) {
+                        slot.entry.files = cached.files;
+                    }
+                    lock.unlock();
+                    std::cout << "Map cache: reusing map state v" << cached.state->version << std::endl;
+                    return cached.state;
+                }
+            }
+
+            // The outdated state lets the builder update derived rasters incrementally
+            std::shared_ptr<const MapState> previous;
+            if (cached.params == params) {
+                previous = cached.state;
+            }
+
+            lock.lock();
+            if (slot.building.valid() || slot.entry.state != cached.state) {
+                // Someone else started or finished a build in the meantime
+                continue;
+            }
+            std::promise<void> done;
+            slot.building = done.get_future().share();
+            lock.unlock();
+
+            // Fingerprint before building so that an edit during the build triggers another rebuild
+            CacheEntry entry;
+            std::shared_ptr<MapState> state;
+            try {
+                entry.files = {fingerprint(map_path), fingerprint(items_json_path), fingerprint(map_yaml_path)};
+                entry.params = params;
+                state = build(previous);
+                if (!state) {
+                    throw std::runtime_error("Map pipeline builder returned no state");
+                }
+                state->content_hash = contentHash(entry.files, params);
+            } catch (...) {
+                lock.lock();
+                slot.building = {};
+                lock.unlock();
+                done.set_value();
+                throw;
+            }
+
+            lock.lock();
+            state->version = next_version++;
+            entry.state = state;
+            slot.entry = std::move(entry);
+            slot.building = {};
+            lock.unlock();
+            done.set_value();
+
+            std::cout << "Map cache: built map state v" << state->version << std::endl;
+            return state;
+        }
+    }
+
+    void invalidate() {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        // Keep the slots, a build in flight still publishes into its own
+        for (auto& [key, slot] : cache) {
+            slot.entry = CacheEntry();
+        }
+    }
+}
@@ -0,0 +1,120 @@
+#include "get_coordinates/getcoord_map_pipeline.hpp"
+#include "get_coordinates/getcoord_scalemap_generation.hpp"
+#include "get_coordinates/getcoord_costmap_generation.hpp"
+#include "get_coordinates/getcoord_walkability_generation.hpp"
+#include "get_coordinates/getcoord_nonTraversable_generation.hpp"
+#include "get_coordinates/getcoord_grid_generation.hpp"
+#include "get_coordinates/getcoord_objectmap_generation.hpp"
+#include "get_coordinates/getcoord_coord_validation.hpp"
+#include "get_coordinates/getcoord_tiling.hpp"
+#include <iostream>
+
+namespace GetCoordMapPipeline {
+    void MapPipeline::run(const cv::Mat& map_img, const Settings& settings,
+                          const GetCoordMapCache::MapState* previous,
+                          GetCoordMapCache::MapState& state,
+                          const ImageSink& save_image) {
+        buildLayers(map_img, settings, previous, state, save_image);
+        render(settings, state, save_image);
+    }
+
+    void MapPipeline::buildLayers(const cv::Mat& map_img, const Settings& settings,
+                                  const GetCoordMapCache::MapState* previous,
+                                  GetCoordMapCache::MapState& state,
+                                  const ImageSink& save_image) {
+        GetCoordMapLayers::MapLayers& layers = state.layers;
+
+        // Process 1: Scale map
+        std::tie(layers.occupancy, state.scaled_resolution) = GetCoordScaleMapGeneration::process(
+            map_img, state.resolution, settings.scale_factor
+        );
+        if (save_image) save_image(layers.occupancy, "02_scaled_map.png");
+
+        // Process 2: Generate cost map, only around the edited region when the previous map has the same geometry
+        if (previous && previous->scaled_resolution == state.scaled_resolution
+            && previous->layers.occupancy.size() == layers.occupancy.size()) {
+            cv::Rect dirty = GetCoordCostmapGeneration::changedRegion(previous->layers.occupancy, layers.occupancy);
+            layers.cost = previous->layers.cost.clone();
+            cv::Rect updated = GetCoordCostmapGeneration::update(
+                layers.cost, layers.occupancy, dirty, state.scaled_resolution, settings.inflation_radius_m
+            );
+            std::cout << "Incremental cost map: map changed in " << dirty.width << "x" << dirty.height 
+                      << " px, recomputed " << updated.width << "x" << updated.height << " px" << std::endl;
+        } else {
+            layers.cost = GetCoordCostmapGeneration::process(
+                layers.occupancy, state.scaled_resolution, settings.inflation_radius_m, settings.tile_size
+            );
+        }
+        if (save_image) save_image(layers.cost, "03_cost_map.png");
+
+        // Walkability bitmap shared by every path query on this map; item boxes are blocked below
+        layers.walkable = GetCoordWalkabilityGeneration::process(layers.cost);
+
+        // Process 3: Free space connected to the map origin
+        GetCoordNonTraversableGeneration::ReachableArea area = GetCoordNonTraversableGeneration::findReachableArea(
+            layers.cost, state.scaled_resolution, state.origin
+        );
+        layers.reachable = GetCoordWalkabilityGeneration::fromMask(area.mask);
+        layers.reachable_seed = area.seed;
+        layers.origin_pixel = area.origin;
+
+        // Item boxes as labels, the same boxes the object map draws
+        layers.labels = GetCoordObjectMapGeneration::labelMap(
+            layers.cost.size(), state.scaled_resolution, state.origin, state.items
+        );
+
+        // Items are obstacles for the pathfinder, as their coloured boxes were on the object map,
+        // so a path to an item ends next to its box rather than at its centre
+        GetCoordWalkabilityGeneration::block(layers.walkable, layers.labels);
+
+        // Nearest valid cell of every pixel, for correcting the points the LLM returns
+        state.snap = GetCoordCoordValidation::buildSnapField(layers);
+    }
+
+    void MapPipeline::render(const Settings& settings, GetCoordMapCache::MapState& state,
+                             const ImageSink& save_image) {
+        const GetCoordMapLayers::MapLayers& layers = state.layers;
+
+        // Process 3: Mark non-traversable areas on the scratch raster
+        GetCoordNonTraversableGeneration::ReachableArea area;
+        area.mask = GetCoordWalkabilityGeneration::toMask(layers.reachable);
+        area.seed = layers.reachable_seed;
+        area.origin = layers.origin_pixel;
+        GetCoordNonTraversableGeneration::paintInto(layers.cost, area, render_buffer);
+
+        if (save_image) {
+            // Mark non-traversable areas in a more visible way for debugging
+            cv::Mat debug_map = render_buffer.clone();
+            
+            // Find black pixels (non-traversable areas) and make them red
+            GetCoordTiling::forEachRowBand(debug_map.rows, settings.tile_size, [&](int row_begin, int row_end) {
+                for (int y = row_begin; y < row_end; y++) {
+                    cv::Vec3b* debug_row = debug_map.ptr<cv::Vec3b>(y);
+                    for (int x = 0; x < debug_map.cols; x++) {
+                        const cv::Vec3b& pixel = debug_row[x];
+                        // If pixel is very dark (non-traversable)
+                        if (pixel[0] < 50 && pixel[1] < 50 && pixel[2] < 50) {
+                            debug_row[x] = cv::Vec3b(0, 0, 200); // Red in BGR
+                        }
+                    }
+                }
+            });
+            
+            save_image(debug_map, "04_debug_non_traversable.png");
+            // The scratch raster is drawn on next, so the sink gets its own copy
+            save_image(render_buffer.clone(), "04_non_traversable_map.png");
+        }
+
+        // Process 4: Draw the grid on the same raster
+        GetCoordGridGeneration::drawInPlace(render_buffer, settings.grid_scale, settings.tile_size);
+        if (save_image) save_image(render_buffer.clone(), "05_grid_map.png");
+
+        // Process 5: Populate map with objects. The object map is kept by the map state,
+        // so it gets a fresh raster instead of the scratch one
+        state.object_map = cv::Mat();
+        GetCoordObjectMapGeneration::renderInto(
+            render_buffer, state.scaled_resolution, state.origin, state.items, state.object_map
+        );
+        if (save_image) save_image(state.object_map, "06_object_map.png");
+    }
+}
@@ -2,11 +2,12 @@
 #include <cmath>
 
 namespace GetCoordNewCoordmapGeneration {
-    std::pair<cv::Mat, float> process(const cv::Mat& object_map, 
-                                     double resolution, 
-                                     const std::vector<float>& origin, 
-                                     const nlohmann::json& result,
-                                     const nlohmann::json& items_data) {
+    cv::Mat process(const cv::Mat& object_map, 
+                    double resolution, 
+                    const std::vector<float>& origin, 
+                    const nlohmann::json& result,
+                    const GetCoordItemStore::ItemStore& items,
+                    float angle_deg) {
         // Create a copy of the object_map
         cv::Mat new_coords_map = object_map.clone();
         
@@ -27,7 +28,6 @@ namespace GetCoordNewCoordmapGeneration {
         int marker_radius = 10;
         cv::Scalar inner_color(0, 255, 0);  // Green center
         cv::Scalar outer_color(0, 0, 255);  // Red outline
-        float angle_deg = 0.0f;  // Default angle
         
         // Draw the marker
         cv::circle(new_coords_map, cv::Point(target_x, target_y), marker_radius + 2, outer_color, 2);
@@ -43,9 +43,13 @@ namespace GetCoordNewCoordmapGeneration {
                 cv::Point(target_x, target_y + marker_radius), 
                 outer_color, 1);
         
-        // If we had more information about the target object, we could calculate 
-        // an orientation angle here. For now, we'll just use 0.0
+        // Draw the heading, 0 degrees at 3 o'clock, counter-clockwise
+        double angle_rad = angle_deg * CV_PI / 180.0;
+        int heading_length = marker_radius * 3;
+        cv::Point heading_end(static_cast<int>(std::lround(target_x + heading_length * std::cos(angle_rad))),
+                              static_cast<int>(std::lround(target_y - heading_length * std::sin(angle_rad))));
+        cv::arrowedLine(new_coords_map, cv::Point(target_x, target_y), heading_end, outer_color, 2);
         
-        return {new_coords_map, angle_deg};
+        return new_coords_map;
     }
 }
\ No newline at end of file
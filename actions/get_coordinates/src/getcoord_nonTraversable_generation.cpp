@@ -1,171 +1,267 @@
 #include "get_coordinates/getcoord_nonTraversable_generation.hpp"
 #include <cmath>
-#include <queue>
 #include <iostream>
 
 namespace GetCoordNonTraversableGeneration {
-    cv::Mat process(const cv::Mat& map_img, double resolution, const std::vector<float>& origin) {
-        // Create a mutable copy of the map image
-        cv::Mat modified_map = map_img.clone();
-        
-        // Convert to BGR if it's not already
-        if (modified_map.channels() == 1) {
-            cv::cvtColor(modified_map, modified_map, cv::COLOR_GRAY2BGR);
+    bool ReachabilityField::isReachable(int x, int y) const {
+        if (x < 0 || x >= cols || y < 0 || y >= rows) {
+            return false;
+        }
+        return steps[static_cast<size_t>(y) * cols + x] >= 0;
+    }
+
+    double ReachabilityField::distance(int x, int y) const {
+        if (!isReachable(x, y)) {
+            return -1.0;
+        }
+        return steps[static_cast<size_t>(y) * cols + x] * resolution / straight_cost;
+    }
+
+    // Binary mask where 255=free space (every channel very light), 0=anything else
+    static cv::Mat freeSpaceMask(const cv::Mat& map_img) {
+        cv::Mat free_space_mask;
+        cv::inRange(map_img, cv::Scalar::all(240), cv::Scalar::all(255), free_space_mask);
+        return free_space_mask;
+    }
+
+    // Use the preferred point as seed if it is free space, else the closest free point
+    // within a small radius, else (only if anywhere is set) the first free point of the map
+    static bool findSeed(const cv::Mat& free_space_mask, cv::Point preferred, cv::Point& seed_point, bool anywhere) {
+        int height = free_space_mask.rows;
+        int width = free_space_mask.cols;
+        seed_point = cv::Point(-1, -1);
+
+        if (preferred.x < 0 || preferred.x >= width || preferred.y < 0 || preferred.y >= height) {
+            if (!anywhere) {
+                std::cout << "Seed point (" << preferred.x << ", " << preferred.y << ") is outside the map." << std::endl;
+                return false;
+            }
+            // Ensure the preferred point is within the map bounds
+            preferred.x = std::max(0, std::min(width - 1, preferred.x));
+            preferred.y = std::max(0, std::min(height - 1, preferred.y));
+        }
+
+        if (free_space_mask.at<uchar>(preferred.y, preferred.x) != 0) {
+            seed_point = preferred;
+            std::cout << "Seed point is in free space, using it directly." << std::endl;
+            return true;
+        }
+
+        // Try to find a free space point near the preferred point
+        const int search_radius = 20; // pixels
+        for (int r = 1; r <= search_radius; ++r) {
+            for (int dy = -r; dy <= r; ++dy) {
+                for (int dx = -r; dx <= r; ++dx) {
+                    // Only check points at distance r
+                    if (std::abs(dx) + std::abs(dy) == r) {
+                        int nx = preferred.x + dx;
+                        int ny = preferred.y + dy;
+                        
+                        // Check bounds
+                        if (nx >= 0 && nx < width && ny >= 0 && ny < height) {
+                            if (free_space_mask.at<uchar>(ny, nx) != 0) {
+                                seed_point = cv::Point(nx, ny);
+                                std::cout << "Found free space seed nearby: (" << nx << ", " << ny << ")" << std::endl;
+                                return true;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        if (!anywhere) {
+            std::cout << "No free space within " << search_radius << " pixels of the seed point." << std::endl;
+            return false;
         }
         
-        // Map size in pixels
-        int height = modified_map.rows;
-        int width = modified_map.cols;
-        
-        // Create a binary mask where 1=free space, 0=obstacles
-        cv::Mat free_space_mask = cv::Mat::zeros(height, width, CV_8UC1);
-        
-        // Also create an obstacle mask to keep track of black pixels
-        cv::Mat obstacle_mask = cv::Mat::zeros(height, width, CV_8UC1);
-        
-        // Define what colors represent obstacles (dark gray or black)
-        // and what colors represent free space (light gray or white)
+        // If still no free space was found nearby, search the entire map
+        std::cout << "Could not find free space nearby, searching entire map..." << std::endl;
         for (int y = 0; y < height; ++y) {
             for (int x = 0; x < width; ++x) {
-                cv::Vec3b pixel = modified_map.at<cv::Vec3b>(y, x);
-                
-                // If pixel is very light (free space)
-                if (pixel[0] >= 240 && pixel[1] >= 240 && pixel[2] >= 240) {
-                    free_space_mask.at<uchar>(y, x) = 1;
-                }
-                // If pixel is very dark (obstacles)
-                else if (pixel[0] <= 50 && pixel[1] <= 50 && pixel[2] <= 50) {
-                    // Mark it in the obstacle mask
-                    obstacle_mask.at<uchar>(y, x) = 1;
+                if (free_space_mask.at<uchar>(y, x) != 0) {
+                    seed_point = cv::Point(x, y);
+                    std::cout << "Found free space seed elsewhere: (" << x << ", " << y << ")" << std::endl;
+                    return true;
                 }
-                // For gray areas (inflation zone), we'll leave them as they are
             }
         }
         
-        // Calculate origin pixel coordinates
-        // The origin in the map.yaml is in world coordinates where:
-        // - origin[0] is x (corresponds to columns in the image)
-        // - origin[1] is y (corresponds to rows in the image)
-        // - We need to convert from world coordinates to pixel coordinates
+        std::cout << "No free space found in the map at all!" << std::endl;
+        return false;
+    }
+
+    // Flood fill over free space, recording the 8-connected chamfer cost to every reachable cell.
+    // The weights are small integers, so a ring of buckets indexed by cost replaces a priority queue.
+    static void floodFill(const cv::Mat& free_space_mask, const cv::Point& seed_point, std::vector<int32_t>& steps) {
+        int height = free_space_mask.rows;
+        int width = free_space_mask.cols;
+        steps.assign(static_cast<size_t>(height) * width, -1);
+
+        auto is_free = [&](int x, int y) {
+            return x >= 0 && x < width && y >= 0 && y < height && free_space_mask.at<uchar>(y, x) != 0;
+        };
+
+        // Pending costs span at most diagonal_cost + 1 consecutive values
+        const int32_t bucket_count = ReachabilityField::diagonal_cost + 1;
+        std::vector<std::vector<int>> buckets(bucket_count);
+        int seed_index = seed_point.y * width + seed_point.x;
+        buckets[0].push_back(seed_index);
+        steps[seed_index] = 0;
+        size_t pending = 1;
+
+        // Straight moves first, then the diagonals
+        const int dx[8] = {0, 1, 0, -1, 1, 1, -1, -1};
+        const int dy[8] = {-1, 0, 1, 0, -1, 1, 1, -1};
         
+        for (int32_t cost = 0; pending > 0; ++cost) {
+            std::vector<int>& bucket = buckets[cost % bucket_count];
+            for (size_t i = 0; i < bucket.size(); ++i) {
+                --pending;
+                int current = bucket[i];
+                // Skip entries superseded by a cheaper path
+                if (steps[current] != cost) continue;
+                int cx = current % width;
+                int cy = current / width;
+                
+                for (int d = 0; d < 8; ++d) {
+                    int nx = cx + dx[d];
+                    int ny = cy + dy[d];
+                    if (!is_free(nx, ny)) continue;
+
+                    // Diagonal steps may not cut a corner
+                    bool diagonal = d >= 4;
+                    if (diagonal && !(is_free(nx, cy) && is_free(cx, ny))) continue;
+
+                    int neighbor = ny * width + nx;
+                    int32_t neighbor_cost = cost + (diagonal ? ReachabilityField::diagonal_cost : ReachabilityField::straight_cost);
+                    if (steps[neighbor] < 0 || neighbor_cost < steps[neighbor]) {
+                        steps[neighbor] = neighbor_cost;
+                        buckets[neighbor_cost % bucket_count].push_back(neighbor);
+                        ++pending;
+                    }
+                }
+            }
+            bucket.clear();
+        }
+    }
+
+    // Convert origin from world to pixel coordinates
+    static cv::Point originPixel(int height, double resolution, const std::vector<float>& origin) {
         // The origin point in the map is the bottom-left corner of the image
         // in world coordinates, but in the image it's the top-left corner
         // So we need to flip the y-coordinate
-        
-        // Convert origin from world to pixel coordinates
         int origin_x = static_cast<int>(-origin[0] / resolution);
         int origin_y = static_cast<int>(height - (-origin[1] / resolution));
+        return cv::Point(origin_x, origin_y);
+    }
+
+    ReachableArea findReachableArea(const cv::Mat& map_img, double resolution, const std::vector<float>& origin) {
+        ReachableArea area;
+
+        // Map size in pixels
+        int height = map_img.rows;
+        int width = map_img.cols;
+        
+        // Create a binary mask where 255=free space, 0=obstacles
+        cv::Mat free_space_mask = freeSpaceMask(map_img);
+        
+        // The origin in the map.yaml is in world coordinates where:
+        // - origin[0] is x (corresponds to columns in the image)
+        // - origin[1] is y (corresponds to rows in the image)
+        cv::Point origin_point = originPixel(height, resolution, origin);
         
         // Ensure the origin is within the map bounds
-        origin_x = std::max(0, std::min(width - 1, origin_x));
-        origin_y = std::max(0, std::min(height - 1, origin_y));
+        area.origin.x = std::max(0, std::min(width - 1, origin_point.x));
+        area.origin.y = std::max(0, std::min(height - 1, origin_point.y));
         
-        std::cout << "Map origin in pixels: (" << origin_x << ", " << origin_y << ")" << std::endl;
+        std::cout << "Map origin in pixels: (" << area.origin.x << ", " << area.origin.y << ")" << std::endl;
         
         // Use the origin as the seed point for flood fill if it's free space
-        cv::Point seed_point(origin_x, origin_y);
+        if (!findSeed(free_space_mask, area.origin, area.seed, true)) {
+            // No free space at all, so nothing is reachable
+            area.seed = cv::Point(-1, -1);
+            area.mask = cv::Mat::zeros(height, width, CV_8UC1);
+            return area;
+        }
         
-        // If the origin is not in free space, find a nearby free space point
-        if (free_space_mask.at<uchar>(seed_point.y, seed_point.x) != 1) {
-            // Try to find a free space point near the origin
-            const int search_radius = 20; // pixels
-            bool found_seed = false;
-            
-            for (int r = 1; r <= search_radius && !found_seed; ++r) {
-                for (int dy = -r; dy <= r && !found_seed; ++dy) {
-                    for (int dx = -r; dx <= r && !found_seed; ++dx) {
-                        // Only check points at distance r
-                        if (std::abs(dx) + std::abs(dy) == r) {
-                            int nx = origin_x + dx;
-                            int ny = origin_y + dy;
-                            
-                            // Check bounds
-                            if (nx >= 0 && nx < width && ny >= 0 && ny < height) {
-                                if (free_space_mask.at<uchar>(ny, nx) == 1) {
-                                    seed_point = cv::Point(nx, ny);
-                                    found_seed = true;
-                                    std::cout << "Found free space seed near origin: (" << nx << ", " << ny << ")" << std::endl;
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-            
-            // If still no free space was found near the origin, search the entire map
-            if (!found_seed) {
-                std::cout << "Could not find free space near origin, searching entire map..." << std::endl;
-                for (int y = 0; y < height && !found_seed; ++y) {
-                    for (int x = 0; x < width && !found_seed; ++x) {
-                        if (free_space_mask.at<uchar>(y, x) == 1) {
-                            seed_point = cv::Point(x, y);
-                            found_seed = true;
-                            std::cout << "Found free space seed elsewhere: (" << x << ", " << y << ")" << std::endl;
-                        }
-                    }
-                }
-                
-                // If no free space was found at all, just return the original map
-                if (!found_seed) {
-                    std::cout << "No free space found in the map at all!" << std::endl;
-                    return modified_map;
-                }
-            }
+        // Scanline flood fill over the free space component containing the seed.
+        // Only pixels equal to the seed value (255) are joined, 4-connected, and the
+        // result is written as 255 into the padded fill mask
+        cv::Mat fill_mask = cv::Mat::zeros(height + 2, width + 2, CV_8UC1);
+        cv::floodFill(free_space_mask, fill_mask, area.seed, cv::Scalar(255), nullptr,
+                      cv::Scalar(0), cv::Scalar(0),
+                      4 | cv::FLOODFILL_FIXED_RANGE | cv::FLOODFILL_MASK_ONLY | (255 << 8));
+        area.mask = fill_mask(cv::Rect(1, 1, width, height));
+        return area;
+    }
+
+    void paintInto(const cv::Mat& map_img, const ReachableArea& area, cv::Mat& dst) {
+        // Convert to BGR if it's not already, reusing dst's buffer when it has the right size.
+        // Gray pixels expand to equal channels, so the masks can come from the single-channel map
+        if (map_img.channels() == 1) {
+            cv::cvtColor(map_img, dst, cv::COLOR_GRAY2BGR);
         } else {
-            std::cout << "Origin is in free space, using as seed point." << std::endl;
+            map_img.copyTo(dst);
         }
+
+        // If no free space was found at all, leave the map as it is
+        if (area.seed.x < 0) {
+            return;
+        }
+
+        cv::Mat free_space_mask = freeSpaceMask(map_img);
         
-        // Draw a marker at the seed point for debugging
-        cv::circle(modified_map, seed_point, 3, cv::Scalar(0, 255, 255), -1); // Yellow circle
-        
-        // Create a mask for the flood fill result
-        cv::Mat reachable_mask = cv::Mat::zeros(height, width, CV_8UC1);
-        
-        // Perform flood fill to identify reachable areas
-        std::queue<cv::Point> queue;
-        queue.push(seed_point);
-        reachable_mask.at<uchar>(seed_point.y, seed_point.x) = 1;
-        
-        // Directions for 4-connectivity
-        const int dx[4] = {0, 1, 0, -1};
-        const int dy[4] = {-1, 0, 1, 0};
+        // Also create an obstacle mask to keep track of very dark pixels.
+        // The two ranges are disjoint, so no free space pixel ends up in it
+        cv::Mat obstacle_mask;
+        cv::inRange(map_img, cv::Scalar::all(0), cv::Scalar::all(50), obstacle_mask);
+        // For gray areas (inflation zone), we'll leave them as they are
         
-        while (!queue.empty()) {
-            cv::Point current = queue.front();
-            queue.pop();
-            
-            // Check neighboring pixels
-            for (int i = 0; i < 4; ++i) {
-                int nx = current.x + dx[i];
-                int ny = current.y + dy[i];
-                
-                // Check if within bounds
-                if (nx >= 0 && nx < width && ny >= 0 && ny < height) {
-                    // If free space and not already marked as reachable
-                    if (free_space_mask.at<uchar>(ny, nx) == 1 && reachable_mask.at<uchar>(ny, nx) == 0) {
-                        reachable_mask.at<uchar>(ny, nx) = 1;
-                        queue.push(cv::Point(nx, ny));
-                    }
-                }
-            }
-        }
+        // Draw a marker at the seed point for debugging
+        cv::circle(dst, area.seed, 3, cv::Scalar(0, 255, 255), -1); // Yellow circle
         
         // Now identify and color unreachable free space areas as RED
         // But don't color over black pixels (obstacles)
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                // If it's free space but not reachable, and NOT an obstacle
-                if (free_space_mask.at<uchar>(y, x) == 1 && reachable_mask.at<uchar>(y, x) == 0 
-                    && obstacle_mask.at<uchar>(y, x) == 0) {
-                    // Mark as non-traversable by making it bright red
-                    modified_map.at<cv::Vec3b>(y, x) = cv::Vec3b(0, 0, 255); // Bright red in BGR
-                }
-            }
-        }
+        cv::Mat unreachable_mask;
+        cv::bitwise_or(area.mask, obstacle_mask, unreachable_mask);
+        cv::bitwise_not(unreachable_mask, unreachable_mask);
+        cv::bitwise_and(unreachable_mask, free_space_mask, unreachable_mask);
+        // Mark as non-traversable by making it bright red
+        dst.setTo(cv::Scalar(0, 0, 255), unreachable_mask); // Bright red in BGR
         
         // Draw a marker at the origin for reference
-        cv::circle(modified_map, cv::Point(origin_x, origin_y), 5, cv::Scalar(0, 255, 0), -1); // Green circle
-        
+        cv::circle(dst, area.origin, 5, cv::Scalar(0, 255, 0), -1); // Green circle
+    }
+
+    cv::Mat process(const cv::Mat& map_img, double resolution, const std::vector<float>& origin) {
+        cv::Mat modified_map;
+        renderInto(map_img, resolution, origin, modified_map);
         return modified_map;
     }
-}
\ No newline at end of file
+
+    void renderInto(const cv::Mat& map_img, double resolution, const std::vector<float>& origin, cv::Mat& dst) {
+        paintInto(map_img, findReachableArea(map_img, resolution, origin), dst);
+    }
+
+    ReachabilityField computeReachability(const cv::Mat& map_img, double resolution,
+                                          const std::vector<float>& origin, const cv::Point* robot_pixel) {
+        ReachabilityField field;
+        field.rows = map_img.rows;
+        field.cols = map_img.cols;
+        field.resolution = resolution;
+
+        // Seed at the robot, falling back to the map origin
+        field.requested = robot_pixel ? *robot_pixel : originPixel(map_img.rows, resolution, origin);
+
+        // A robot seed must lie next to the robot, anywhere else the field would not be the robot's
+        cv::Mat free_space_mask = freeSpaceMask(map_img);
+        if (!findSeed(free_space_mask, field.requested, field.seed, robot_pixel == nullptr)) {
+            field.steps.assign(static_cast<size_t>(field.rows) * field.cols, -1);
+            return field;
+        }
+
+        floodFill(free_space_mask, field.seed, field.steps);
+        return field;
+    }
+}
@@ -3,6 +3,38 @@
 #include <cmath>
 
 namespace GetCoordObjectMapGeneration {
+    // Padding around each item box in pixels
+    static const int rectangle_padding = 5;
+
+    // Corners of an item's padded box in map pixels, clamped to the map
+    static std::pair<cv::Point, cv::Point> itemCorners(const GetCoordItemStore::ItemStore& items, size_t index,
+                                                       double resolution, const std::vector<float>& origin,
+                                                       int map_width, int map_height) {
+        // Extract coordinates and dimensions
+        double coord_x = items.x(index);
+        double coord_y = items.y(index);
+        double width = items.width(index);
+        double height = items.height(index);
+
+        // Convert world coordinates to map pixel coordinates
+        int map_x = static_cast<int>((coord_x - origin[0]) / resolution);
+        int map_y = map_height - static_cast<int>((coord_y - origin[1]) / resolution);
+
+        // Convert dimensions to pixels
+        int width_px = static_cast<int>(width / resolution);
+        int height_px = static_cast<int>(height / resolution);
+
+        cv::Point top_left(
+            std::max(0, std::min(map_width - 1, map_x - width_px / 2 - rectangle_padding)),
+            std::max(0, std::min(map_height - 1, map_y - height_px / 2 - rectangle_padding))
+        );
+        cv::Point bottom_right(
+            std::max(0, std::min(map_width - 1, map_x + width_px / 2 + rectangle_padding)),
+            std::max(0, std::min(map_height - 1, map_y + height_px / 2 + rectangle_padding))
+        );
+        return {top_left, bottom_right};
+    }
+
     // Helper class for object map generation
     class ObjectMapGenerator {
     private:
@@ -28,26 +60,24 @@ namespace GetCoordObjectMapGeneration {
     public:
         ObjectMapGenerator() : gen(rd()) {}
 
-        cv::Mat generateMap(const cv::Mat& robot_map, double resolution, 
+        void generateMap(const cv::Mat& robot_map, double resolution, 
                          const std::vector<float>& origin, 
-                         const nlohmann::json& items_data) {
-            // Create a copy of the robot map
-            cv::Mat object_map_color = robot_map.clone();
-
-            // Ensure we're working with a color image
+                         const GetCoordItemStore::ItemStore& items,
+                         cv::Mat& overlay) {
+            // Ensure we're blending onto a color image
+            cv::Mat object_map_color = robot_map;
             if (object_map_color.channels() == 1) {
-                cv::cvtColor(object_map_color, object_map_color, cv::COLOR_GRAY2BGR);
+                cv::cvtColor(robot_map, object_map_color, cv::COLOR_GRAY2BGR);
             }
 
             // Map dimensions
             int map_height = object_map_color.rows;
             int map_width = object_map_color.cols;
 
-            // Create an overlay image
-            cv::Mat overlay = object_map_color.clone();
+            // Create an overlay image; it is blended in place and becomes the result
+            object_map_color.copyTo(overlay);
 
-            // Padding and border properties
-            int rectangle_padding = 5;
+            // Border properties
             int border_thickness = 1;
             cv::Scalar border_color(0, 0, 0);  // Black border
 
@@ -61,53 +91,29 @@ namespace GetCoordObjectMapGeneration {
             std::vector<LabelInfo> labels_to_draw;
 
             // Iterate over items
-            for (const auto& [item_class, items_list] : items_data["items"].items()) {
-                for (const auto& item : items_list) {
-                    std::string item_id = item["id"];
-                    
-                    // Extract coordinates and dimensions
-                    double coord_x = item["coordinates"]["x"];
-                    double coord_y = item["coordinates"]["y"];
-                    double width = item["dimensions"]["width"];
-                    double height = item["dimensions"]["height"];
-
-                    // Convert world coordinates to map pixel coordinates
-                    int map_x = static_cast<int>((coord_x - origin[0]) / resolution);
-                    int map_y = map_height - static_cast<int>((coord_y - origin[1]) / resolution);
-
-                    // Convert dimensions to pixels
-                    int width_px = static_cast<int>(width / resolution);
-                    int height_px = static_cast<int>(height / resolution);
-
-                    // Calculate rectangle coordinates with padding
-                    cv::Point top_left(
-                        std::max(0, std::min(map_width - 1, map_x - width_px / 2 - rectangle_padding)),
-                        std::max(0, std::min(map_height - 1, map_y - height_px / 2 - rectangle_padding))
-                    );
-                    cv::Point bottom_right(
-                        std::max(0, std::min(map_width - 1, map_x + width_px / 2 + rectangle_padding)),
-                        std::max(0, std::min(map_height - 1, map_y + height_px / 2 + rectangle_padding))
-                    );
-
-                    // Generate random color
-                    cv::Scalar color = generateRandomColor();
-
-                    // Draw filled rectangle
-                    cv::rectangle(overlay, top_left, bottom_right, color, -1);
-
-                    // Draw rectangle border
-                    cv::rectangle(overlay, top_left, bottom_right, border_color, border_thickness);
-
-                    // Draw "X" lines inside the rectangle
-                    cv::line(overlay, top_left, bottom_right, border_color, 1);
-                    cv::line(overlay, 
-                        cv::Point(top_left.x, bottom_right.y), 
-                        cv::Point(bottom_right.x, top_left.y), 
-                        border_color, 1);
-
-                    // Store label information
-                    labels_to_draw.push_back({item_id, top_left, bottom_right, color});
-                }
+            labels_to_draw.reserve(items.size());
+            for (size_t i = 0; i < items.size(); ++i) {
+                // Calculate rectangle coordinates with padding
+                auto [top_left, bottom_right] = itemCorners(items, i, resolution, origin, map_width, map_height);
+
+                // Generate random color
+                cv::Scalar color = generateRandomColor();
+
+                // Draw filled rectangle
+                cv::rectangle(overlay, top_left, bottom_right, color, -1);
+
+                // Draw rectangle border
+                cv::rectangle(overlay, top_left, bottom_right, border_color, border_thickness);
+
+                // Draw "X" lines inside the rectangle
+                cv::line(overlay, top_left, bottom_right, border_color, 1);
+                cv::line(overlay, 
+                    cv::Point(top_left.x, bottom_right.y), 
+                    cv::Point(bottom_right.x, top_left.y), 
+                    border_color, 1);
+
+                // Store label information
+                labels_to_draw.push_back({std::string(items.id(i)), top_left, bottom_right, color});
             }
 
             // Draw labels
@@ -139,15 +145,42 @@ namespace GetCoordObjectMapGeneration {
 
             // Apply transparency
             double alpha = 0.7;
-            cv::addWeighted(overlay, alpha, object_map_color, 1 - alpha, 0, object_map_color);
-
-            return object_map_color;
+            cv::addWeighted(overlay, alpha, object_map_color, 1 - alpha, 0, overlay);
         }
     };
 
     cv::Mat process(const cv::Mat& grid_map, double resolution, 
-                  const std::vector<float>& origin, const nlohmann::json& items_data) {
+                  const std::vector<float>& origin, const GetCoordItemStore::ItemStore& items) {
+        cv::Mat object_map;
+        renderInto(grid_map, resolution, origin, items, object_map);
+        return object_map;
+    }
+
+    void renderInto(const cv::Mat& grid_map, double resolution, 
+                    const std::vector<float>& origin, const GetCoordItemStore::ItemStore& items,
+                    cv::Mat& dst) {
         ObjectMapGenerator generator;
-        return generator.generateMap(grid_map, resolution, origin, items_data);
+        generator.generateMap(grid_map, resolution, origin, items, dst);
+    }
+
+    cv::Rect itemBox(const GetCoordItemStore::ItemStore& items, size_t index, double resolution,
+                     const std::vector<float>& origin, const cv::Size& size) {
+        auto [top_left, bottom_right] = itemCorners(items, index, resolution, origin, size.width, size.height);
+        return cv::Rect(top_left, bottom_right + cv::Point(1, 1));
+    }
+
+    cv::Mat labelMap(const cv::Size& size, double resolution, 
+                     const std::vector<float>& origin, const GetCoordItemStore::ItemStore& items) {
+        if (items.size() > 65535) {
+            throw std::runtime_error("Too many items for a 16-bit label map");
+        }
+        cv::Mat labels = cv::Mat::zeros(size, CV_16UC1);
+
+        // Same boxes as the rendered map, later items cover earlier ones
+        for (size_t i = 0; i < items.size(); ++i) {
+            labels(itemBox(items, i, resolution, origin, size)).setTo(static_cast<uint16_t>(i + 1));
+        }
+
+        return labels;
     }
-}
\ No newline at end of file
+}
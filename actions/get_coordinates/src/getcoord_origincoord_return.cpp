@@ -55,4 +55,18 @@ namespace GetCoordOriginCoordReturn {
             return error_response;
         }
     }
+
+    nlohmann::json toMapPixels(const nlohmann::json& result, const GetCoordRoiCrop::RoiView& view) {
+        nlohmann::json response = result;
+        if (!response.contains("coordinates") || !response["coordinates"]["x"].is_number() 
+            || !response["coordinates"]["y"].is_number()) {
+            return response;
+        }
+
+        nlohmann::json& coords = response["coordinates"];
+        cv::Point map_pixel = view.toMap(coords["x"].get<double>(), coords["y"].get<double>());
+        coords["x"] = map_pixel.x;
+        coords["y"] = map_pixel.y;
+        return response;
+    }
 }
\ No newline at end of file
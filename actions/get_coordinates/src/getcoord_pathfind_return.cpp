@@ -1,92 +1,476 @@
 #include "get_coordinates/getcoord_pathfind_return.hpp"
-#include <queue>
-#include <unordered_set>
+#include "get_coordinates/getcoord_objectmap_generation.hpp"
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <functional>
 #include <limits>
+#include <vector>
 
 namespace GetCoordPathfindReturn {
-    // Custom hash function for pair<int, int>
-    struct PairHash {
-        template <class T1, class T2>
-        std::size_t operator () (const std::pair<T1, T2>& p) const {
-            auto h1 = std::hash<T1>{}(p.first);
-            auto h2 = std::hash<T2>{}(p.second);
-            return h1 ^ h2;
+    // Open list entry: total cost and flat cell index
+    struct OpenEntry {
+        double f;
+        int index;
+
+        bool operator>(const OpenEntry& other) const {
+            return f > other.f;
         }
     };
 
-    // Node class for A* pathfinding
-    class Node {
-    public:
-        std::pair<int, int> position;
-        Node* parent;
-        double g;  // Cost from start to current node
-        double h;  // Estimated cost from current to goal
-        double f;  // Total cost
+    // Search state sized to the map and reused between calls.
+    // Cells are reset lazily: a cell only counts as seen/closed if its stamp matches the current generation.
+    struct Workspace {
+        std::vector<double> g;             // Cost from start to cell
+        std::vector<int> parent;           // Predecessor cell, used by jump point pruning
+        std::vector<uint32_t> seen;        // Generation in which g was last written
+        std::vector<uint32_t> closed;      // Generation in which the cell was expanded
+        std::vector<OpenEntry> open_list;  // Binary min-heap on f
+        uint32_t generation = 0;
+
+        void reset(size_t cell_count) {
+            if (g.size() != cell_count) {
+                g.assign(cell_count, 0.0);
+                parent.assign(cell_count, -1);
+                seen.assign(cell_count, 0);
+                closed.assign(cell_count, 0);
+                generation = 0;
+            }
+            open_list.clear();
+
+            // On wrap-around the stamps are ambiguous, so clear them once
+            if (++generation == 0) {
+                std::fill(seen.begin(), seen.end(), 0);
+                std::fill(closed.begin(), closed.end(), 0);
+                generation = 1;
+            }
+        }
+
+        void push(double f, int index) {
+            open_list.push_back({f, index});
+            std::push_heap(open_list.begin(), open_list.end(), std::greater<OpenEntry>());
+        }
+
+        OpenEntry pop() {
+            std::pop_heap(open_list.begin(), open_list.end(), std::greater<OpenEntry>());
+            OpenEntry top = open_list.back();
+            open_list.pop_back();
+            return top;
+        }
+    };
+
+    static thread_local Workspace workspace;
 
-        Node(std::pair<int, int> pos, Node* par = nullptr) 
-            : position(pos), parent(par), g(0), h(0), f(0) {}
+    static constexpr double SQRT2 = 1.4142135623730951;
+
+    // Octile distance, exact on an obstacle-free 8-connected grid
+    static double octile(int row_a, int col_a, int row_b, int col_b) {
+        int dx = std::abs(row_a - row_b);
+        int dy = std::abs(col_a - col_b);
+        return (dx + dy) + (SQRT2 - 2.0) * std::min(dx, dy);
+    }
 
-        // Custom comparator for priority queue
-        struct Compare {
-            bool operator()(const Node* a, const Node* b) const {
-                return a->f > b->f;
+    // The item box a search approaches. The box itself is blocked in the walkability
+    // bitmap, so the goal is any cell touching it, diagonals included.
+    struct GoalBox {
+        cv::Rect box;
+
+        int gapRow(int row) const {
+            return std::max({0, box.y - row, row - (box.y + box.height - 1)});
+        }
+
+        int gapCol(int col) const {
+            return std::max({0, box.x - col, col - (box.x + box.width - 1)});
+        }
+
+        bool isGoal(int row, int col) const {
+            return std::max(gapRow(row), gapCol(col)) == 1;
+        }
+
+        // Distance from a cell to the box, 0 inside it
+        double distance(int row, int col) const {
+            return std::hypot(gapRow(row), gapCol(col));
+        }
+
+        // Lower bound of the path length to the nearest goal cell
+        double estimate(int row, int col, bool diagonal) const {
+            int dr = std::max(0, gapRow(row) - 1);
+            int dc = std::max(0, gapCol(col) - 1);
+            return diagonal ? octile(dr, dc, 0, 0) : std::hypot(dr, dc);
+        }
+    };
+
+    // Best cell found by a search: the cheapest goal cell if one was reached, else the closest cell to the box
+    struct SearchResult {
+        int best_index;
+        double cost;
+        bool reached = false;
+    };
+
+    // Tracks the cell outside the box closest to it seen so far; equally close cells go to the cheaper one
+    struct ClosestTracker {
+        const GoalBox& goal;
+        double min_distance;
+        SearchResult best;
+
+        void update(int row, int col, int index, double cost) {
+            double distance = goal.distance(row, col);
+            if (distance == 0.0) return;
+            if (distance < min_distance || (distance == min_distance && cost < best.cost)) {
+                min_distance = distance;
+                best = {index, cost};
             }
-        };
+        }
     };
 
-    // Heuristic function (Euclidean distance)
-    static double heuristic(const std::pair<int, int>& a, const std::pair<int, int>& b) {
-        int dx = a.first - b.first;
-        int dy = a.second - b.second;
-        return std::sqrt(dx*dx + dy*dy);
+    using GetCoordWalkabilityGeneration::WalkabilityMap;
+
+    // A* over the 4- or 8-connected grid. Diagonal moves may not cut corners.
+    static SearchResult gridSearch(const WalkabilityMap& walkability, int start_row, int start_col,
+                                   const GoalBox& goal, bool diagonal) {
+        const int width = walkability.cols;
+        Workspace& ws = workspace;
+        ws.reset(static_cast<size_t>(walkability.rows) * width);
+        const uint32_t generation = ws.generation;
+
+        // Movements: up, down, left, right, then the diagonals
+        static const int movements[8][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1},
+                                            {-1, -1}, {-1, 1}, {1, -1}, {1, 1}};
+        const int move_count = diagonal ? 8 : 4;
+
+        const int start_index = start_row * width + start_col;
+        ws.g[start_index] = 0.0;
+        ws.seen[start_index] = generation;
+        ws.push(goal.estimate(start_row, start_col, diagonal), start_index);
+
+        ClosestTracker closest{goal, std::numeric_limits<double>::infinity(), {start_index, 0.0}};
+
+        while (!ws.open_list.empty()) {
+            const int current_index = ws.pop().index;
+
+            // Skip if already processed
+            if (ws.closed[current_index] == generation) continue;
+            ws.closed[current_index] = generation;
+
+            const int row = current_index / width;
+            const int col = current_index % width;
+            const double current_g = ws.g[current_index];
+            closest.update(row, col, current_index, current_g);
+
+            // Stop at the first cell next to the item box, the cheapest one
+            if (goal.isGoal(row, col)) {
+                return {current_index, current_g, true};
+            }
+
+            // Explore neighbors; the padded border is never walkable, so no bounds check is needed
+            for (int m = 0; m < move_count; ++m) {
+                const int dr = movements[m][0];
+                const int dc = movements[m][1];
+                const int neighbor_row = row + dr;
+                const int neighbor_col = col + dc;
+
+                if (!walkability.isWalkable(neighbor_row, neighbor_col)) continue;
+                const bool is_diagonal = dr != 0 && dc != 0;
+                if (is_diagonal && !(walkability.isWalkable(row + dr, col) && walkability.isWalkable(row, col + dc))) continue;
+
+                const int neighbor_index = neighbor_row * width + neighbor_col;
+                if (ws.closed[neighbor_index] == generation) continue;
+
+                // Only push if this is the cheapest way found so far
+                const double neighbor_g = current_g + (is_diagonal ? SQRT2 : 1.0);
+                if (ws.seen[neighbor_index] == generation && ws.g[neighbor_index] <= neighbor_g) continue;
+                ws.seen[neighbor_index] = generation;
+                ws.g[neighbor_index] = neighbor_g;
+
+                ws.push(neighbor_g + goal.estimate(neighbor_row, neighbor_col, diagonal), neighbor_index);
+            }
+        }
+
+        return closest.best;
     }
 
-    // Check if a position is walkable
-    static bool isWalkable(const cv::Mat& object_map, const std::pair<int, int>& position) {
-        int row = position.first;
-        int col = position.second;
+    // Dijkstra wavefront from the start over the whole reachable region.
+    // Afterwards the workspace holds the cost-to-come of every settled (closed) cell.
+    static void sweep(const WalkabilityMap& walkability, int start_row, int start_col, bool diagonal) {
+        const int width = walkability.cols;
+        Workspace& ws = workspace;
+        ws.reset(static_cast<size_t>(walkability.rows) * width);
+        const uint32_t generation = ws.generation;
+
+        static const int movements[8][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1},
+                                            {-1, -1}, {-1, 1}, {1, -1}, {1, 1}};
+        const int move_count = diagonal ? 8 : 4;
+
+        const int start_index = start_row * width + start_col;
+        ws.g[start_index] = 0.0;
+        ws.seen[start_index] = generation;
+        ws.push(0.0, start_index);
+
+        while (!ws.open_list.empty()) {
+            const int current_index = ws.pop().index;
+            if (ws.closed[current_index] == generation) continue;
+            ws.closed[current_index] = generation;
+
+            const int row = current_index / width;
+            const int col = current_index % width;
+            const double current_g = ws.g[current_index];
+
+            for (int m = 0; m < move_count; ++m) {
+                const int dr = movements[m][0];
+                const int dc = movements[m][1];
+                if (!walkability.isWalkable(row + dr, col + dc)) continue;
+                const bool is_diagonal = dr != 0 && dc != 0;
+                if (is_diagonal && !(walkability.isWalkable(row + dr, col) && walkability.isWalkable(row, col + dc))) continue;
+
+                const int neighbor_index = (row + dr) * width + (col + dc);
+                if (ws.closed[neighbor_index] == generation) continue;
+
+                const double neighbor_g = current_g + (is_diagonal ? SQRT2 : 1.0);
+                if (ws.seen[neighbor_index] == generation && ws.g[neighbor_index] <= neighbor_g) continue;
+                ws.seen[neighbor_index] = generation;
+                ws.g[neighbor_index] = neighbor_g;
+                ws.push(neighbor_g, neighbor_index);
+            }
+        }
+    }
+
+    // Settled cell to approach the goal box from after a sweep: the cheapest cell next to the box,
+    // else the one closest to it, searched in growing rings around the box. Ties on distance go to
+    // the cheaper cell. Returns -1 if nothing was settled.
+    static int nearestSettled(int rows, int cols, const GoalBox& goal) {
+        const Workspace& ws = workspace;
+        const uint32_t generation = ws.generation;
+
+        int best_index = -1;
+        double best_distance = std::numeric_limits<double>::infinity();
+        const cv::Rect& box = goal.box;
+        const int max_gap = std::max(rows, cols);
+
+        // Every cell on ring k is at least k away from the box, so stop once k passes the best distance
+        for (int gap = 1; gap <= max_gap && gap <= best_distance; ++gap) {
+            const int top = box.y - gap;
+            const int bottom = box.y + box.height - 1 + gap;
+            const int left = box.x - gap;
+            const int right = box.x + box.width - 1 + gap;
+            for (int r = std::max(top, 0); r <= std::min(bottom, rows - 1); ++r) {
+                const bool edge_row = (r == top || r == bottom);
+                const int step = edge_row ? 1 : right - left;
+                for (int c = left; c <= right; c += step) {
+                    if (c < 0 || c >= cols) continue;
+                    const int index = r * cols + c;
+                    if (ws.closed[index] != generation) continue;
+
+                    // The whole first ring touches the box, so only the cost counts there
+                    const double distance = gap == 1 ? 1.0 : goal.distance(r, c);
+                    if (distance < best_distance ||
+                        (distance == best_distance && ws.g[index] < ws.g[best_index])) {
+                        best_distance = distance;
+                        best_index = index;
+                    }
+                }
+            }
+        }
+        return best_index;
+    }
+
+    // Jump Point Search over the 8-connected grid with the same no-corner-cutting rule as gridSearch.
+    // Goal cells are jump points, so the first one expanded is reached at the 8-connected path cost.
+    // Only jump points are expanded: when no goal cell is reachable, the closest cell is the closest
+    // jump point and its cost the length of the path through its parents. That cell may lie farther
+    // from the box than gridSearch's, and the path is not always the shortest one to it.
+    class JumpPointSearch {
+    public:
+        JumpPointSearch(const WalkabilityMap& walkability, const GoalBox& goal)
+            : walkability(walkability), width(walkability.cols), goal(goal) {}
+
+        SearchResult run(int start_row, int start_col) {
+            Workspace& ws = workspace;
+            ws.reset(static_cast<size_t>(walkability.rows) * width);
+            const uint32_t generation = ws.generation;
+
+            const int start_index = start_row * width + start_col;
+            ws.g[start_index] = 0.0;
+            ws.parent[start_index] = -1;
+            ws.seen[start_index] = generation;
+            ws.push(goal.estimate(start_row, start_col, true), start_index);
+
+            ClosestTracker closest{goal, std::numeric_limits<double>::infinity(), {start_index, 0.0}};
+
+            int neighbors[8][2];
+            while (!ws.open_list.empty()) {
+                const int current_index = ws.pop().index;
+                if (ws.closed[current_index] == generation) continue;
+                ws.closed[current_index] = generation;
+
+                const int row = current_index / width;
+                const int col = current_index % width;
+                const double current_g = ws.g[current_index];
+                closest.update(row, col, current_index, current_g);
+
+                if (goal.isGoal(row, col)) {
+                    return {current_index, current_g, true};
+                }
+
+                const int count = prunedNeighbors(row, col, ws.parent[current_index], neighbors);
+                for (int n = 0; n < count; ++n) {
+                    const int dr = neighbors[n][0] - row;
+                    const int dc = neighbors[n][1] - col;
+                    const int jump_index = jump(neighbors[n][0], neighbors[n][1], dr, dc);
+                    if (jump_index < 0 || ws.closed[jump_index] == generation) continue;
+
+                    const int jump_row = jump_index / width;
+                    const int jump_col = jump_index % width;
+                    const double jump_g = current_g + octile(row, col, jump_row, jump_col);
+                    if (ws.seen[jump_index] == generation && ws.g[jump_index] <= jump_g) continue;
+                    ws.seen[jump_index] = generation;
+                    ws.g[jump_index] = jump_g;
+                    ws.parent[jump_index] = current_index;
+
+                    ws.push(jump_g + goal.estimate(jump_row, jump_col, true), jump_index);
+                }
+            }
+
+            return closest.best;
+        }
+
+    private:
+        const WalkabilityMap& walkability;
+        const int width;
+        const GoalBox& goal;
+
+        bool walkable(int row, int col) const {
+            return walkability.isWalkable(row, col);
+        }
+
+        // Neighbours worth jumping towards, given the direction we arrived from
+        int prunedNeighbors(int row, int col, int parent_index, int (&out)[8][2]) const {
+            int count = 0;
+            auto add = [&](int r, int c) {
+                out[count][0] = r;
+                out[count][1] = c;
+                ++count;
+            };
+
+            if (parent_index < 0) {
+                for (int dr = -1; dr <= 1; ++dr) {
+                    for (int dc = -1; dc <= 1; ++dc) {
+                        if ((dr == 0 && dc == 0) || !walkable(row + dr, col + dc)) continue;
+                        if (dr != 0 && dc != 0 && !(walkable(row + dr, col) && walkable(row, col + dc))) continue;
+                        add(row + dr, col + dc);
+                    }
+                }
+                return count;
+            }
+
+            const int parent_row = parent_index / width;
+            const int parent_col = parent_index % width;
+            const int dr = (row > parent_row) - (row < parent_row);
+            const int dc = (col > parent_col) - (col < parent_col);
+
+            if (dr != 0 && dc != 0) {
+                const bool vertical = walkable(row + dr, col);
+                const bool horizontal = walkable(row, col + dc);
+                if (vertical) add(row + dr, col);
+                if (horizontal) add(row, col + dc);
+                if (vertical && horizontal) add(row + dr, col + dc);
+            } else if (dc != 0) {
+                const bool next = walkable(row, col + dc);
+                const bool up = walkable(row - 1, col);
+                const bool down = walkable(row + 1, col);
+                if (next) {
+                    add(row, col + dc);
+                    if (up) add(row - 1, col + dc);
+                    if (down) add(row + 1, col + dc);
+                }
+                if (up) add(row - 1, col);
+                if (down) add(row + 1, col);
+            } else {
+                const bool next = walkable(row + dr, col);
+                const bool left = walkable(row, col - 1);
+                const bool right = walkable(row, col + 1);
+                if (next) {
+                    add(row + dr, col);
+                    if (left) add(row + dr, col - 1);
+                    if (right) add(row + dr, col + 1);
+                }
+                if (left) add(row, col - 1);
+                if (right) add(row, col + 1);
+            }
+            return count;
+        }
+
+        // Walk in a straight line from (row, col) until a jump point, the goal or a wall is hit
+        int jumpStraight(int row, int col, int dr, int dc) {
+            while (walkable(row, col)) {
+                const int index = row * width + col;
+                if (goal.isGoal(row, col)) return index;
+
+                // A forced neighbour appears where the wall beside the previous cell opens up
+                if (dc != 0) {
+                    if ((walkable(row - 1, col) && !walkable(row - 1, col - dc)) ||
+                        (walkable(row + 1, col) && !walkable(row + 1, col - dc))) return index;
+                } else {
+                    if ((walkable(row, col - 1) && !walkable(row - dr, col - 1)) ||
+                        (walkable(row, col + 1) && !walkable(row - dr, col + 1))) return index;
+                }
+                row += dr;
+                col += dc;
+            }
+            return -1;
+        }
+
+        // Jump from (row, col) in direction (dr, dc)
+        int jump(int row, int col, int dr, int dc) {
+            if (dr == 0 || dc == 0) {
+                return jumpStraight(row, col, dr, dc);
+            }
+
+            while (walkable(row, col)) {
+                const int index = row * width + col;
+                if (goal.isGoal(row, col)) return index;
 
-        // Check bounds
-        if (row < 0 || row >= object_map.rows || 
-            col < 0 || col >= object_map.cols) {
-            return false;
+                // A diagonal cell is a jump point if a straight scan from it finds one
+                if (jumpStraight(row, col + dc, 0, dc) >= 0 || jumpStraight(row + dr, col, dr, 0) >= 0) {
+                    return index;
+                }
+
+                // Moving on diagonally must not cut a corner
+                if (!(walkable(row + dr, col) && walkable(row, col + dc))) return -1;
+                row += dr;
+                col += dc;
+            }
+            return -1;
         }
+    };
 
-        // Check pixel value
-        if (object_map.channels() == 3) {
-            // Color image: check if all channels are 255
-            cv::Vec3b pixel = object_map.at<cv::Vec3b>(row, col);
-            return pixel[0] == 255 && pixel[1] == 255 && pixel[2] == 255;
-        } else {
-            // Grayscale image: check if pixel is 255
-            return object_map.at<uchar>(row, col) == 255;
+    // Search from the start towards the cells next to the goal box
+    static SearchResult approach(const WalkabilityMap& walkability, int start_row, int start_col,
+                                 const GoalBox& goal, SearchMode mode) {
+        switch (mode) {
+            case SearchMode::JumpPoint:
+                return JumpPointSearch(walkability, goal).run(start_row, start_col);
+            case SearchMode::EightConnected:
+                return gridSearch(walkability, start_row, start_col, goal, true);
+            case SearchMode::FourConnected:
+            default:
+                return gridSearch(walkability, start_row, start_col, goal, false);
         }
     }
 
-    nlohmann::json process(const cv::Mat& object_map, 
+    nlohmann::json process(const GetCoordWalkabilityGeneration::WalkabilityMap& walkability, 
                          double resolution, 
                          const std::vector<float>& origin, 
-                         const nlohmann::json& items_data, 
+                         const GetCoordItemStore::ItemStore& items, 
                          const nlohmann::json& robot_coords, 
-                         const nlohmann::json& assistant_reply) {
+                         const nlohmann::json& assistant_reply,
+                         SearchMode mode) {
         try {
             // Extract target ID from assistant reply
             std::string target_id = assistant_reply.value("target_id", "");
 
             // Find target item coordinates
-            nlohmann::json item_coords;
-            for (const auto& [item_class, items_list] : items_data["items"].items()) {
-                for (const auto& item : items_list) {
-                    if (item["id"] == target_id) {
-                        item_coords = item["coordinates"];
-                        break;
-                    }
-                }
-                if (!item_coords.empty()) break;
-            }
-
-            if (item_coords.empty()) {
+            int item_index = items.find(target_id);
+            if (item_index < 0) {
                 return {
                     {"success", false},
                     {"error", "Target ID not found in items_data"},
@@ -95,8 +479,8 @@ namespace GetCoordPathfindReturn {
             }
 
             // Map dimensions
-            int map_height = object_map.rows;
-            int map_width = object_map.cols;
+            int map_height = walkability.rows;
+            int map_width = walkability.cols;
 
             // Extract origin coordinates
             double origin_x = origin[0];
@@ -114,9 +498,7 @@ namespace GetCoordPathfindReturn {
             double robot_y = robot_coords["y"];
             auto robot_position = world_to_map(robot_x, robot_y);
 
-            double item_x = item_coords["x"];
-            double item_y = item_coords["y"];
-            auto item_position = world_to_map(item_x, item_y);
+            auto item_position = world_to_map(items.x(item_index), items.y(item_index));
 
             // Check map bounds
             auto is_within_bounds = [&](const std::pair<int, int>& pos) {
@@ -140,95 +522,133 @@ namespace GetCoordPathfindReturn {
                 };
             }
 
-            // A* Pathfinding
-            std::priority_queue<Node*, std::vector<Node*>, Node::Compare> open_list;
-            std::unordered_set<std::pair<int, int>, PairHash> closed_set;
-
-            // Movements: up, down, left, right
-            std::vector<std::pair<int, int>> movements = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+            // Search towards the box the item occupies on the map, blocked in the walkability bitmap
+            GoalBox goal{GetCoordObjectMapGeneration::itemBox(items, item_index, resolution, origin, cv::Size(map_width, map_height))};
+            SearchResult search = approach(walkability, robot_position.first, robot_position.second, goal, mode);
+            const int best_row = search.best_index / map_width;
+            const int best_col = search.best_index % map_width;
 
-            // Starting node
-            Node* start_node = new Node(robot_position);
-            start_node->h = heuristic(robot_position, item_position);
-            start_node->f = start_node->h;
+            // Create result
+            nlohmann::json result = assistant_reply;
+            result["coordinates"] = {
+                {"x", best_col},  // col index as x-coordinate
+                {"y", best_row}   // row index as y-coordinate
+            };
+            result["path_cost"] = search.cost * resolution;
+            result["approach_distance"] = goal.distance(best_row, best_col) * resolution;
 
-            double min_distance = start_node->h;
-            Node* best_node = start_node;
+            result["success"] = true;
+            result["error"] = "none";
 
-            open_list.push(start_node);
+            return result;
 
-            while (!open_list.empty()) {
-                Node* current_node = open_list.top();
-                open_list.pop();
+        } catch (const std::exception& e) {
+            return {
+                {"success", false},
+                {"error", "PathfindingError"},
+                {"message", std::string("Error in pathfinding: ") + e.what()}
+            };
+        }
+    }
 
-                auto current_position = current_node->position;
+    nlohmann::json processBatch(const GetCoordWalkabilityGeneration::WalkabilityMap& walkability, 
+                              double resolution, 
+                              const std::vector<float>& origin, 
+                              const GetCoordItemStore::ItemStore& items, 
+                              const nlohmann::json& robot_coords, 
+                              const std::vector<std::string>& target_ids,
+                              SearchMode mode) {
+        nlohmann::json results = nlohmann::json::array();
+        try {
+            int map_height = walkability.rows;
+            int map_width = walkability.cols;
 
-                // Skip if already processed
-                if (closed_set.count(current_position)) continue;
+            // Convert world to map coordinates
+            auto world_to_map = [&](double x, double y) {
+                int col = static_cast<int>((x - origin[0]) / resolution);
+                int row = map_height - static_cast<int>((y - origin[1]) / resolution) - 1;
+                return std::make_pair(row, col);
+            };
+            auto is_within_bounds = [&](const std::pair<int, int>& pos) {
+                return pos.first >= 0 && pos.first < map_height && 
+                       pos.second >= 0 && pos.second < map_width;
+            };
 
-                closed_set.insert(current_position);
+            auto robot_position = world_to_map(robot_coords["x"].get<double>(), robot_coords["y"].get<double>());
+            if (!is_within_bounds(robot_position)) {
+                return {{
+                    {"success", false},
+                    {"error", "Robot coordinates out of map bounds"},
+                    {"message", "The robot's position is outside the map boundaries."}
+                }};
+            }
 
-                // Update best node if closer to the item
-                double current_distance = heuristic(current_position, item_position);
-                if (current_distance < min_distance) {
-                    min_distance = current_distance;
-                    best_node = current_node;
+            // One wavefront from the robot serves every target; jump point search instead runs one
+            // search per target, which is cheaper than a full sweep when only a few are asked for
+            const bool per_target = mode == SearchMode::JumpPoint;
+            if (!per_target) {
+                sweep(walkability, robot_position.first, robot_position.second, mode == SearchMode::EightConnected);
+            }
+            const Workspace& ws = workspace;
+
+            for (const auto& id : target_ids) {
+                int item_index = items.find(id);
+                if (item_index < 0) {
+                    results.push_back({
+                        {"target_id", id},
+                        {"success", false},
+                        {"error", "Target ID not found in items_data"}
+                    });
+                    continue;
                 }
 
-                // If reached the item position, break
-                if (current_position == item_position) {
-                    best_node = current_node;
-                    break;
+                auto item_position = world_to_map(items.x(item_index), items.y(item_index));
+                if (!is_within_bounds(item_position)) {
+                    results.push_back({
+                        {"target_id", id},
+                        {"success", false},
+                        {"error", "Item coordinates out of map bounds"}
+                    });
+                    continue;
                 }
 
-                // Explore neighbors
-                for (const auto& move : movements) {
-                    std::pair<int, int> neighbor_position = {
-                        current_position.first + move.first, 
-                        current_position.second + move.second
-                    };
-
-                    if (!isWalkable(object_map, neighbor_position) || 
-                        closed_set.count(neighbor_position)) continue;
-
-                    Node* neighbor_node = new Node(neighbor_position, current_node);
-                    neighbor_node->g = current_node->g + 1;
-                    neighbor_node->h = heuristic(neighbor_position, item_position);
-                    neighbor_node->f = neighbor_node->g + neighbor_node->h;
-
-                    open_list.push(neighbor_node);
+                GoalBox goal{GetCoordObjectMapGeneration::itemBox(items, item_index, resolution, origin, cv::Size(map_width, map_height))};
+                SearchResult search;
+                if (per_target) {
+                    search = approach(walkability, robot_position.first, robot_position.second, goal, mode);
+                } else {
+                    search.best_index = nearestSettled(map_height, map_width, goal);
+                    search.cost = search.best_index < 0 ? 0.0 : ws.g[search.best_index];
                 }
-            }
-
-            // Create result
-            nlohmann::json result = assistant_reply;
-            result["coordinates"] = {
-                {"x", best_node->position.second},  // col index as x-coordinate
-                {"y", best_node->position.first}    // row index as y-coordinate
-            };
 
-            result["success"] = true;
-            result["error"] = "none";
+                const int approach_row = search.best_index / map_width;
+                const int approach_col = search.best_index % map_width;
+                if (search.best_index < 0 || goal.distance(approach_row, approach_col) == 0.0) {
+                    results.push_back({
+                        {"target_id", id},
+                        {"success", false},
+                        {"error", "No reachable approach cell"}
+                    });
+                    continue;
+                }
 
-            // Clean up dynamically allocated nodes
-            std::unordered_set<Node*> to_delete;
-            Node* current = best_node;
-            while (current) {
-                to_delete.insert(current);
-                current = current->parent;
-            }
-            for (auto node : to_delete) {
-                delete node;
+                results.push_back({
+                    {"target_id", id},
+                    {"success", true},
+                    {"coordinates", {{"x", approach_col}, {"y", approach_row}}},
+                    {"path_cost", search.cost * resolution},
+                    {"approach_distance", goal.distance(approach_row, approach_col) * resolution}
+                });
             }
 
-            return result;
+            return results;
 
         } catch (const std::exception& e) {
-            return {
+            return {{
                 {"success", false},
                 {"error", "PathfindingError"},
-                {"message", std::string("Error in pathfinding: ") + e.what()}
-            };
+                {"message", std::string("Error in batch pathfinding: ") + e.what()}
+            }};
         }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,54 @@
+#include "get_coordinates/getcoord_roi_crop.hpp"
+#include <algorithm>
+
+namespace GetCoordRoiCrop {
+    cv::Rect boundingRegion(const std::vector<cv::Point>& points, int margin_px, int min_edge_px, 
+                            const cv::Size& map_size) {
+        cv::Rect map_rect(cv::Point(0, 0), map_size);
+        if (points.empty()) {
+            return map_rect;
+        }
+
+        cv::Rect box = cv::boundingRect(points);
+        box.x -= margin_px;
+        box.y -= margin_px;
+        box.width += 2 * margin_px;
+        box.height += 2 * margin_px;
+
+        // Grow small regions around their center so the LLM keeps some context
+        if (box.width < min_edge_px) {
+            box.x -= (min_edge_px - box.width) / 2;
+            box.width = min_edge_px;
+        }
+        if (box.height < min_edge_px) {
+            box.y -= (min_edge_px - box.height) / 2;
+            box.height = min_edge_px;
+        }
+
+        box &= map_rect;
+        return box.empty() ? map_rect : box;
+    }
+
+    RoiView crop(const cv::Mat& object_map, const cv::Rect& roi, int max_edge_px, cv::Mat& dst) {
+        RoiView view;
+        cv::Rect map_rect(0, 0, object_map.cols, object_map.rows);
+        view.roi = roi.empty() ? map_rect : (roi & map_rect);
+        if (view.roi.empty()) {
+            view.roi = map_rect;
+        }
+
+        cv::Mat region = object_map(view.roi);
+        int edge = std::max(view.roi.width, view.roi.height);
+        if (max_edge_px <= 0 || edge <= max_edge_px) {
+            dst = region;
+            return view;
+        }
+
+        // Bound the payload regardless of the map extent
+        view.scale = static_cast<double>(max_edge_px) / edge;
+        cv::Size size(std::max(1, static_cast<int>(view.roi.width * view.scale)),
+                      std::max(1, static_cast<int>(view.roi.height * view.scale)));
+        cv::resize(region, dst, size, 0, 0, cv::INTER_AREA);
+        return view;
+    }
+}
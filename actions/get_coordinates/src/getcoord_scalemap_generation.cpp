@@ -17,21 +17,20 @@ namespace GetCoordScaleMapGeneration {
             return {map_img.clone(), resolution};
         }
 
-        cv::Mat scaled_img;
-        cv::resize(map_img, scaled_img, cv::Size(new_width, new_height), 0, 0, interpolation);
-
         double new_resolution = resolution / scale_factor;
 
         int max_dim = std::max(new_width, new_height);
 
         cv::Mat square_img;
-        if (scaled_img.channels() == 3) {
+        if (map_img.channels() == 3) {
             square_img = cv::Mat::zeros(max_dim, max_dim, CV_8UC3);
         } else {
             square_img = cv::Mat::zeros(max_dim, max_dim, CV_8UC1);
         }
 
-        scaled_img.copyTo(square_img(cv::Rect(0, 0, new_width, new_height)));
+        // Resize straight into the top-left of the square image instead of through a temporary
+        cv::Mat scaled_view = square_img(cv::Rect(0, 0, new_width, new_height));
+        cv::resize(map_img, scaled_view, cv::Size(new_width, new_height), 0, 0, interpolation);
 
         return {square_img, new_resolution};
     }
@@ -0,0 +1,220 @@
+#include "get_coordinates/getcoord_spatial_index.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace GetCoordSpatialIndex {
+    // Upper bound on the bucket count; larger facilities get coarser cells
+    static const double max_cells = 1 << 20;
+
+    // Edge-to-edge distance between two footprints, 0 when they overlap
+    static double boxDistance(const Box& a, const Box& b) {
+        double dx = std::max({0.0, a.min_x - b.max_x, b.min_x - a.max_x});
+        double dy = std::max({0.0, a.min_y - b.max_y, b.min_y - a.max_y});
+        return std::sqrt(dx * dx + dy * dy);
+    }
+
+    SpatialIndex SpatialIndex::build(const GetCoordItemStore::ItemStore& items, double cell_size) {
+        SpatialIndex index;
+        if (items.size() == 0) {
+            return index;
+        }
+
+        // Footprints and their common bounds
+        index.boxes.reserve(items.size());
+        Box bounds{INFINITY, INFINITY, -INFINITY, -INFINITY};
+        for (size_t i = 0; i < items.size(); ++i) {
+            Box box;
+            box.min_x = items.x(i) - items.width(i) / 2;
+            box.max_x = items.x(i) + items.width(i) / 2;
+            box.min_y = items.y(i) - items.height(i) / 2;
+            box.max_y = items.y(i) + items.height(i) / 2;
+            index.boxes.push_back(box);
+
+            bounds.min_x = std::min(bounds.min_x, box.min_x);
+            bounds.min_y = std::min(bounds.min_y, box.min_y);
+            bounds.max_x = std::max(bounds.max_x, box.max_x);
+            bounds.max_y = std::max(bounds.max_y, box.max_y);
+        }
+
+        // Grid geometry, coarsened when the facility would need too many cells
+        double width = bounds.max_x - bounds.min_x;
+        double height = bounds.max_y - bounds.min_y;
+        index.cell_size = cell_size;
+        if (index.cell_size <= 0.0) {
+            // About two items per cell on average
+            double area = std::max(width * height, 1e-6);
+            index.cell_size = std::max(std::sqrt(2.0 * area / items.size()), 0.25);
+        }
+        double cells = std::ceil(width / index.cell_size) * std::ceil(height / index.cell_size);
+        if (cells > max_cells) {
+            index.cell_size *= std::sqrt(cells / max_cells) * 1.01;
+        }
+        index.grid_x = bounds.min_x;
+        index.grid_y = bounds.min_y;
+        index.cols = std::max(1, static_cast<int>(std::ceil(width / index.cell_size)));
+        index.rows = std::max(1, static_cast<int>(std::ceil(height / index.cell_size)));
+
+        // Counting pass, then fill every cell a footprint overlaps
+        index.cell_start.assign(static_cast<size_t>(index.rows) * index.cols + 1, 0);
+        for (const Box& box : index.boxes) {
+            for (int cy = index.cellY(box.min_y); cy <= index.cellY(box.max_y); ++cy) {
+                for (int cx = index.cellX(box.min_x); cx <= index.cellX(box.max_x); ++cx) {
+                    ++index.cell_start[static_cast<size_t>(cy) * index.cols + cx + 1];
+                }
+            }
+        }
+        for (size_t c = 1; c < index.cell_start.size(); ++c) {
+            index.cell_start[c] += index.cell_start[c - 1];
+        }
+        index.cell_items.resize(index.cell_start.back());
+        std::vector<uint32_t> fill(index.cell_start.begin(), index.cell_start.end() - 1);
+        for (uint32_t i = 0; i < index.boxes.size(); ++i) {
+            const Box& box = index.boxes[i];
+            for (int cy = index.cellY(box.min_y); cy <= index.cellY(box.max_y); ++cy) {
+                for (int cx = index.cellX(box.min_x); cx <= index.cellX(box.max_x); ++cx) {
+                    index.cell_items[fill[static_cast<size_t>(cy) * index.cols + cx]++] = i;
+                }
+            }
+        }
+
+        return index;
+    }
+
+    int SpatialIndex::cellX(double x) const {
+        int cx = static_cast<int>(std::floor((x - grid_x) / cell_size));
+        return std::clamp(cx, 0, cols - 1);
+    }
+
+    int SpatialIndex::cellY(double y) const {
+        int cy = static_cast<int>(std::floor((y - grid_y) / cell_size));
+        return std::clamp(cy, 0, rows - 1);
+    }
+
+    template <typename Fn>
+    void SpatialIndex::forEachInBox(const Box& query, Fn&& fn) const {
+        int cx0 = cellX(query.min_x);
+        int cx1 = cellX(query.max_x);
+        int cy0 = cellY(query.min_y);
+        int cy1 = cellY(query.max_y);
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                size_t cell = static_cast<size_t>(cy) * cols + cx;
+                for (uint32_t k = cell_start[cell]; k < cell_start[cell + 1]; ++k) {
+                    uint32_t i = cell_items[k];
+                    // Only report an item from the first queried cell it is listed in
+                    const Box& box = boxes[i];
+                    if (cx == std::max(cellX(box.min_x), cx0) && cy == std::max(cellY(box.min_y), cy0)) {
+                        fn(i);
+                    }
+                }
+            }
+        }
+    }
+
+    // Squared distance from a point to a footprint
+    static double squaredDistance(const Box& box, double x, double y) {
+        double dx = std::max({0.0, box.min_x - x, x - box.max_x});
+        double dy = std::max({0.0, box.min_y - y, y - box.max_y});
+        return dx * dx + dy * dy;
+    }
+
+    double SpatialIndex::distanceTo(uint32_t index, double x, double y) const {
+        return std::sqrt(squaredDistance(boxes[index], x, y));
+    }
+
+    void SpatialIndex::nearest(double x, double y, size_t k, std::vector<uint32_t>& out) const {
+        out.clear();
+        k = std::min(k, boxes.size());
+        if (k == 0) {
+            return;
+        }
+
+        // Best candidates so far, ordered by squared distance then index
+        std::vector<std::pair<double, uint32_t>> best;
+        best.reserve(k + 1);
+        auto consider = [&](uint32_t i) {
+            for (const auto& candidate : best) {
+                if (candidate.second == i) {
+                    return;
+                }
+            }
+            std::pair<double, uint32_t> entry(squaredDistance(boxes[i], x, y), i);
+            if (best.size() == k && !(entry < best.back())) {
+                return;
+            }
+            best.insert(std::upper_bound(best.begin(), best.end(), entry), entry);
+            if (best.size() > k) {
+                best.pop_back();
+            }
+        };
+
+        // Expand square rings of cells around the query; nothing in ring d or beyond is closer than
+        // the edge of the block of rings already visited, or (d - 1) cells when the query is off the grid
+        int cx = cellX(x);
+        int cy = cellY(y);
+        bool on_grid = x >= grid_x && x <= grid_x + cols * cell_size &&
+                       y >= grid_y && y <= grid_y + rows * cell_size;
+        int max_ring = std::max(std::max(cx, cols - 1 - cx), std::max(cy, rows - 1 - cy));
+        for (int d = 0; d <= max_ring; ++d) {
+            if (best.size() == k && d > 0) {
+                double bound = (d - 1) * cell_size;
+                if (on_grid) {
+                    bound = INFINITY;
+                    if (cx - d >= 0) bound = std::min(bound, x - (grid_x + (cx - d + 1) * cell_size));
+                    if (cx + d < cols) bound = std::min(bound, grid_x + (cx + d) * cell_size - x);
+                    if (cy - d >= 0) bound = std::min(bound, y - (grid_y + (cy - d + 1) * cell_size));
+                    if (cy + d < rows) bound = std::min(bound, grid_y + (cy + d) * cell_size - y);
+                }
+                if (bound > 0.0 && bound * bound > best.back().first) {
+                    break;
+                }
+            }
+            for (int r = std::max(0, cy - d); r <= std::min(rows - 1, cy + d); ++r) {
+                bool edge_row = std::abs(r - cy) == d;
+                for (int c = std::max(0, cx - d); c <= std::min(cols - 1, cx + d); ++c) {
+                    if (!edge_row && std::abs(c - cx) != d) {
+                        continue;
+                    }
+                    size_t cell = static_cast<size_t>(r) * cols + c;
+                    for (uint32_t i = cell_start[cell]; i < cell_start[cell + 1]; ++i) {
+                        consider(cell_items[i]);
+                    }
+                }
+            }
+        }
+
+        for (const auto& candidate : best) {
+            out.push_back(candidate.second);
+        }
+    }
+
+    void SpatialIndex::withinRadius(double x, double y, double radius, std::vector<uint32_t>& out) const {
+        out.clear();
+        if (boxes.empty() || radius < 0.0) {
+            return;
+        }
+        Box query{x - radius, y - radius, x + radius, y + radius};
+        forEachInBox(query, [&](uint32_t i) {
+            if (distanceTo(i, x, y) <= radius) {
+                out.push_back(i);
+            }
+        });
+        std::sort(out.begin(), out.end());
+    }
+
+    void SpatialIndex::adjacentTo(uint32_t index, double gap, std::vector<uint32_t>& out) const {
+        out.clear();
+        if (index >= boxes.size() || gap < 0.0) {
+            return;
+        }
+        const Box& center = boxes[index];
+        Box query{center.min_x - gap, center.min_y - gap, center.max_x + gap, center.max_y + gap};
+        forEachInBox(query, [&](uint32_t i) {
+            if (i != index && boxDistance(center, boxes[i]) <= gap) {
+                out.push_back(i);
+            }
+        });
+        std::sort(out.begin(), out.end());
+    }
+}
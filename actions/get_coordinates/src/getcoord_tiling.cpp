@@ -0,0 +1,45 @@
+#include "get_coordinates/getcoord_tiling.hpp"
+#include <algorithm>
+
+namespace GetCoordTiling {
+    std::vector<Tile> makeTiles(const cv::Size& size, int tile_size, int halo) {
+        std::vector<Tile> tiles;
+        if (tile_size <= 0) {
+            tile_size = std::max(size.width, size.height);
+        }
+
+        cv::Rect bounds(0, 0, size.width, size.height);
+        for (int y = 0; y < size.height; y += tile_size) {
+            for (int x = 0; x < size.width; x += tile_size) {
+                Tile tile;
+                tile.core = cv::Rect(x, y, tile_size, tile_size) & bounds;
+                tile.padded = cv::Rect(x - halo, y - halo, tile_size + 2 * halo, tile_size + 2 * halo) & bounds;
+                tiles.push_back(tile);
+            }
+        }
+        return tiles;
+    }
+
+    void forEachTile(const std::vector<Tile>& tiles, const std::function<void(const Tile&)>& fn) {
+        cv::parallel_for_(cv::Range(0, static_cast<int>(tiles.size())), [&](const cv::Range& range) {
+            for (int i = range.start; i < range.end; ++i) {
+                fn(tiles[i]);
+            }
+        });
+    }
+
+    void forEachRowBand(int rows, int band_rows, const std::function<void(int, int)>& fn) {
+        if (band_rows <= 0 || band_rows >= rows) {
+            fn(0, rows);
+            return;
+        }
+
+        int bands = (rows + band_rows - 1) / band_rows;
+        cv::parallel_for_(cv::Range(0, bands), [&](const cv::Range& range) {
+            for (int band = range.start; band < range.end; ++band) {
+                int row_begin = band * band_rows;
+                fn(row_begin, std::min(rows, row_begin + band_rows));
+            }
+        });
+    }
+}
@@ -0,0 +1,89 @@
+#include "get_coordinates/getcoord_walkability_generation.hpp"
+#include <stdexcept>
+
+namespace GetCoordWalkabilityGeneration {
+    // Pack the cells whose value passes the predicate, leaving the border blocked
+    template <typename Predicate>
+    static WalkabilityMap pack(const cv::Mat& plane, Predicate walkable) {
+        WalkabilityMap walkability;
+        walkability.rows = plane.rows;
+        walkability.cols = plane.cols;
+
+        // Padded row length rounded up to whole words
+        walkability.stride = ((static_cast<size_t>(plane.cols) + 2 + 63) / 64) * 64;
+        walkability.bits.assign((static_cast<size_t>(plane.rows) + 2) * walkability.stride / 64, 0);
+
+        for (int row = 0; row < plane.rows; ++row) {
+            const uchar* plane_row = plane.ptr<uchar>(row);
+            size_t row_bit = static_cast<size_t>(row + 1) * walkability.stride + 1;
+
+            for (int col = 0; col < plane.cols; ++col) {
+                if (walkable(plane_row[col])) {
+                    size_t bit = row_bit + col;
+                    walkability.bits[bit >> 6] |= uint64_t(1) << (bit & 63);
+                }
+            }
+        }
+
+        return walkability;
+    }
+
+    WalkabilityMap process(const cv::Mat& cost_map) {
+        if (cost_map.channels() != 1) {
+            throw std::runtime_error("Walkability expects a single-channel cost map");
+        }
+        return pack(cost_map, [](uchar cost) { return cost == 255; });
+    }
+
+    WalkabilityMap fromMask(const cv::Mat& mask) {
+        if (mask.channels() != 1) {
+            throw std::runtime_error("Walkability expects a single-channel mask");
+        }
+        return pack(mask, [](uchar value) { return value != 0; });
+    }
+
+    // Clear the cells whose value is non-zero
+    template <typename T>
+    static void clearSet(WalkabilityMap& walkability, const cv::Mat& mask) {
+        for (int row = 0; row < mask.rows; ++row) {
+            const T* mask_row = mask.ptr<T>(row);
+            size_t row_bit = static_cast<size_t>(row + 1) * walkability.stride + 1;
+
+            for (int col = 0; col < mask.cols; ++col) {
+                if (mask_row[col] != 0) {
+                    size_t bit = row_bit + col;
+                    walkability.bits[bit >> 6] &= ~(uint64_t(1) << (bit & 63));
+                }
+            }
+        }
+    }
+
+    void block(WalkabilityMap& walkability, const cv::Mat& mask) {
+        if (mask.empty()) {
+            return;
+        }
+        if (mask.rows != walkability.rows || mask.cols != walkability.cols) {
+            throw std::runtime_error("Walkability mask size does not match the bitmap");
+        }
+        if (mask.type() == CV_16UC1) {
+            clearSet<uint16_t>(walkability, mask);
+        } else if (mask.type() == CV_8UC1) {
+            clearSet<uchar>(walkability, mask);
+        } else {
+            throw std::runtime_error("Walkability expects a CV_8UC1 or CV_16UC1 mask");
+        }
+    }
+
+    cv::Mat toMask(const WalkabilityMap& walkability) {
+        cv::Mat mask = cv::Mat::zeros(walkability.rows, walkability.cols, CV_8UC1);
+        for (int row = 0; row < walkability.rows; ++row) {
+            uchar* mask_row = mask.ptr<uchar>(row);
+            for (int col = 0; col < walkability.cols; ++col) {
+                if (walkability.isWalkable(row, col)) {
+                    mask_row[col] = 255;
+                }
+            }
+        }
+        return mask;
+    }
+}
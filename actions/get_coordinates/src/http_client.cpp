@@ -0,0 +1,166 @@
+#include "get_coordinates/http_client.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+namespace get_coordinates {
+
+// Idle handles kept for reuse; more concurrent requests get temporary handles
+static const size_t max_idle_handles = 4;
+
+static size_t appendToString(void* contents, size_t size, size_t nmemb, void* user) {
+    size_t length = size * nmemb;
+    try {
+        static_cast<std::string*>(user)->append(static_cast<char*>(contents), length);
+        return length;
+    } catch (const std::bad_alloc&) {
+        return 0;
+    }
+}
+
+static size_t discard(void*, size_t size, size_t nmemb, void*) {
+    return size * nmemb;
+}
+
+HttpClient& HttpClient::instance() {
+    static HttpClient client;
+    return client;
+}
+
+HttpClient::HttpClient() {
+    curl_global_init(CURL_GLOBAL_ALL);
+
+    share = curl_share_init();
+    if (share) {
+        curl_share_setopt(share, CURLSHOPT_LOCKFUNC, &HttpClient::lockShare);
+        curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, &HttpClient::unlockShare);
+        curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+    }
+    debug_logging = std::getenv("GET_COORDINATES_HTTP_DEBUG") != nullptr;
+    if (debug_logging) {
+        std::cout << "[DEBUG HTTP] Client initialized, " << curl_version() << std::endl;
+    }
+}
+
+HttpClient::~HttpClient() {
+    for (CURL* handle : idle_handles) {
+        curl_easy_cleanup(handle);
+    }
+    if (share) {
+        curl_share_cleanup(share);
+    }
+    curl_global_cleanup();
+}
+
+void HttpClient::lockShare(CURL*, curl_lock_data data, curl_lock_access, void* client) {
+    static_cast<HttpClient*>(client)->share_locks[data].lock();
+}
+
+void HttpClient::unlockShare(CURL*, curl_lock_data data, void* client) {
+    static_cast<HttpClient*>(client)->share_locks[data].unlock();
+}
+
+CURL* HttpClient::acquire() {
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        if (!idle_handles.empty()) {
+            CURL* handle = idle_handles.back();
+            idle_handles.pop_back();
+            return handle;
+        }
+    }
+
+    CURL* handle = curl_easy_init();
+    if (!handle) {
+        throw std::runtime_error("Failed to initialize cURL handle");
+    }
+    if (share) {
+        curl_easy_setopt(handle, CURLOPT_SHARE, share);
+    }
+    curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+    curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+    curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(handle, CURLOPT_CONNECTTIMEOUT_MS, 10000L);
+    return handle;
+}
+
+void HttpClient::release(CURL* handle) {
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        if (idle_handles.size() < max_idle_handles) {
+            idle_handles.push_back(handle);
+            return;
+        }
+    }
+    curl_easy_cleanup(handle);
+}
+
+HttpClient::Response HttpClient::post(const std::string& url, const curl_slist* headers, 
+                                      const std::string& body, long timeout_ms) {
+    CURL* handle = acquire();
+    Response response;
+
+    curl_easy_setopt(handle, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(handle, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(handle, CURLOPT_POST, 1L);
+    curl_easy_setopt(handle, CURLOPT_POSTFIELDS, body.data());
+    curl_easy_setopt(handle, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(body.size()));
+    curl_easy_setopt(handle, CURLOPT_TIMEOUT_MS, timeout_ms);
+    curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, appendToString);
+    curl_easy_setopt(handle, CURLOPT_WRITEDATA, &response.body);
+
+    CURLcode result = curl_easy_perform(handle);
+    curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &response.status);
+    curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &response.new_connections);
+    curl_easy_getinfo(handle, CURLINFO_TOTAL_TIME, &response.total_time_s);
+
+    // Drop per-request pointers before the handle goes back to the pool
+    curl_easy_setopt(handle, CURLOPT_HTTPHEADER, nullptr);
+    curl_easy_setopt(handle, CURLOPT_POSTFIELDS, nullptr);
+    curl_easy_setopt(handle, CURLOPT_WRITEDATA, nullptr);
+    release(handle);
+
+    request_count++;
+    connection_count += static_cast<uint64_t>(response.new_connections);
+    if (result != CURLE_OK) {
+        failure_count++;
+        throw std::runtime_error(std::string("cURL request failed: ") + curl_easy_strerror(result));
+    }
+    return response;
+}
+
+void HttpClient::preconnect(const std::string& url, long timeout_ms) {
+    std::call_once(preconnect_once, [&] {
+        // A HEAD request leaves a connection in the shared cache that later POSTs can reuse,
+        // unlike CURLOPT_CONNECT_ONLY; the status code does not matter
+        CURL* handle = acquire();
+        curl_easy_setopt(handle, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(handle, CURLOPT_NOBODY, 1L);
+        curl_easy_setopt(handle, CURLOPT_TIMEOUT_MS, timeout_ms);
+        curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, discard);
+        CURLcode result = curl_easy_perform(handle);
+        if (result != CURLE_OK && debug_logging) {
+            std::cout << "[DEBUG HTTP] Preconnect to " << url << " failed: " << curl_easy_strerror(result) << std::endl;
+        }
+        long new_connections = 0;
+        curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &new_connections);
+        connection_count += static_cast<uint64_t>(new_connections);
+
+        curl_easy_setopt(handle, CURLOPT_NOBODY, 0L);
+        release(handle);
+    });
+}
+
+HttpClient::Stats HttpClient::stats() const {
+    Stats result;
+    result.requests = request_count.load();
+    result.new_connections = connection_count.load();
+    result.failures = failure_count.load();
+    return result;
+}
+
+} // namespace get_coordinates
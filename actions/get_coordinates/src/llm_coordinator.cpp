@@ -13,21 +13,26 @@ LLMCoordinator::~LLMCoordinator() {
     std::cout << "[DEBUG LLM] LLMCoordinator destructor called" << std::endl;
 }
 
-void LLMCoordinator::initialize(const Json::Value& data_json, 
-                               const std::string& instructions,
+void LLMCoordinator::initialize(const std::string& instructions,
                                const std::string& map_data_str) {
     std::cout << "[DEBUG LLM] initialize called" << std::endl;
-    this->data = data_json;
     this->INSTRUCTIONS = instructions;
     this->map_data = map_data_str;
     std::cout << "[DEBUG LLM] initialize completed" << std::endl;
 }
 
-std::string LLMCoordinator::getcoord_search(const Json::Value& message, const Json::Value& object_map) {
+void LLMCoordinator::initialize_connection() {
+    std::cout << "[DEBUG LLM] initialize_connection called" << std::endl;
+    ai_core.initialize_connection();
+}
+
+std::string LLMCoordinator::getcoord_search(const Json::Value& message, const std::string& object_map) {
     std::cout << "[DEBUG LLM] getcoord_search called" << std::endl;
     
     // Get message attributes - just use the description field
     std::string object_description = message.get("description", " ").asString();
+    // Neighbourhood of the request when the caller narrowed it down, every item otherwise
+    std::string object_list = message.isMember("objects") ? message["objects"].asString() : map_data;
     std::string error_log = "";
     
     std::cout << "[DEBUG LLM] Got object_description: " << object_description << std::endl;
@@ -35,7 +40,7 @@ std::string LLMCoordinator::getcoord_search(const Json::Value& message, const Js
     // Call LLM_Search and find coordinates
     std::cout << "[DEBUG LLM] Calling LLM_Search to find coordinates" << std::endl;
     log_info("Requesting coord from AI with description: " + object_description);
-    std::string assistant_reply = LLM_Search(object_description, error_log, object_map);
+    std::string assistant_reply = LLM_Search(object_description, error_log, object_map, object_list);
     
     std::cout << "[DEBUG LLM] Got LLM_Search response, length: " << assistant_reply.length() << std::endl;
     if (assistant_reply.empty()) {
@@ -76,117 +81,66 @@ std::string LLMCoordinator::getcoord_search(const Json::Value& message, const Js
 
 std::string LLMCoordinator::LLM_Search(const std::string& object_description, 
                                       const std::string& error_log, 
-                                      const Json::Value& object_map) {
+                                      const std::string& object_map,
+                                      const std::string& object_list) {
     std::cout << "[DEBUG LLM] LLM_Search called for description: " << object_description << std::endl;
         
-    // Initialize messages with system instructions
-    Json::Value messages(Json::arrayValue);
+    // Messages are written straight into the request body; the image is copied into it once
+    std::string error_info;
+    if (!error_log.empty()) {
+        error_info = "\n An error has previously come up, below is the thread of messages between you and the user.\n"
+            " Please use this information and try to determine the correct object and return its coordinates.\n"
+            " If the object is still not clear, continue until success or until user asks to skip.\n";
+    }
+    ChatRequestBuilder request(INSTRUCTIONS.size() + object_list.size() + object_map.size() + 
+                               object_description.size() + error_info.size() + error_log.size() + 512);
 
     // System instruction
-    Json::Value systemMsg;
-    systemMsg["role"] = "system";
-
-    Json::Value systemContent(Json::arrayValue);
-    Json::Value systemTextContent;
-    systemTextContent["type"] = "text";
-    systemTextContent["text"] = INSTRUCTIONS;
-    systemContent.append(systemTextContent);
-
-    systemMsg["content"] = systemContent;
-    messages.append(systemMsg);
+    request.beginMessage("system");
+    request.addText(INSTRUCTIONS);
+    request.endMessage();
 
     // Add the object list
-    Json::Value objectListMsg;
-    objectListMsg["role"] = "user";
-
-    Json::Value objectListContent(Json::arrayValue);
-    Json::Value objectListTextContent;
-    objectListTextContent["type"] = "text";
-    objectListTextContent["text"] = "The list of objects registered are: " + map_data;
-    objectListContent.append(objectListTextContent);
-
-    objectListMsg["content"] = objectListContent;
-    messages.append(objectListMsg);
-
-    // Add the map
-    Json::Value mapMsg;
-    mapMsg["role"] = "user";
-
-    Json::Value mapContent(Json::arrayValue);
-    Json::Value mapTextContent;
-    mapTextContent["type"] = "text";
-    mapTextContent["text"] = "The map is: ";
-    mapContent.append(mapTextContent);
-
-    Json::Value mapImageContent;
-    mapImageContent["type"] = "image_url";
-
-    Json::Value imageUrl;
-    // Assuming object_map is already a base64 string
-    std::string base64Map = object_map.asString();
-    std::cout << "[DEBUG LLM] base64Map length: " << base64Map.length() << std::endl;
-    imageUrl["url"] = "data:image/jpeg;base64," + base64Map;
-
-    mapImageContent["image_url"] = imageUrl;
-    mapContent.append(mapImageContent);
-
-    mapMsg["content"] = mapContent;
-    messages.append(mapMsg);
+    request.beginMessage("user");
+    request.addText("The list of objects registered are: " + object_list);
+    request.endMessage();
+
+    // Add the map, object_map is either a complete data URL or a bare base64 JPEG
+    std::cout << "[DEBUG LLM] object_map length: " << object_map.length() << std::endl;
+    request.beginMessage("user");
+    request.addText("The map is: ");
+    if (object_map.compare(0, 5, "data:") == 0) {
+        request.addImageUrl(object_map);
+    } else {
+        request.addImageUrl("data:image/jpeg;base64," + object_map);
+    }
+    request.endMessage();
 
     // Add the object description
-    Json::Value objectMsg;
-    objectMsg["role"] = "user";
-
-    Json::Value objectContent(Json::arrayValue);
-    Json::Value objectTextContent;
-    objectTextContent["type"] = "text";
-    objectTextContent["text"] = "Return the coordinates for object with description: " + object_description;
-    objectContent.append(objectTextContent);
-
-    objectMsg["content"] = objectContent;
-    messages.append(objectMsg);
+    request.beginMessage("user");
+    request.addText("Return the coordinates for object with description: " + object_description);
+    request.endMessage();
 
     // Add error log if it exists
     if (!error_log.empty()) {
         std::cout << "[DEBUG LLM] Adding error log" << std::endl;
-        std::string error_info = "\n An error has previously come up, below is the thread of messages between you and the user.\n"
-            " Please use this information and try to determine the correct object and return its coordinates.\n"
-            " If the object is still not clear, continue until success or until user asks to skip.\n";
-
-        Json::Value errorInfoMsg;
-        errorInfoMsg["role"] = "system";
-
-        Json::Value errorInfoContent(Json::arrayValue);
-        Json::Value errorInfoTextContent;
-        errorInfoTextContent["type"] = "text";
-        errorInfoTextContent["text"] = error_info;
-        errorInfoContent.append(errorInfoTextContent);
-
-        errorInfoMsg["content"] = errorInfoContent;
-        messages.append(errorInfoMsg);
-
-        Json::Value errorLogMsg;
-        errorLogMsg["role"] = "assistant";
-
-        Json::Value errorLogContent(Json::arrayValue);
-        Json::Value errorLogTextContent;
-        errorLogTextContent["type"] = "text";
-        errorLogTextContent["text"] = error_log;
-        errorLogContent.append(errorLogTextContent);
+        request.beginMessage("system");
+        request.addText(error_info);
+        request.endMessage();
 
-        errorLogMsg["content"] = errorLogContent;
-        messages.append(errorLogMsg);
+        request.beginMessage("assistant");
+        request.addText(error_log);
+        request.endMessage();
     }
 
     // Get response from AI
     try {
         // Call to AI service
         std::cout << "[DEBUG LLM] Preparing to call AI_Image_Prompt" << std::endl;
-        std::string messages_json = Json::FastWriter().write(messages);
-        std::cout << "[DEBUG LLM] Messages JSON prepared, length: " << messages_json.length() << std::endl;
+        std::cout << "[DEBUG LLM] Messages JSON prepared, length: " << request.size() << std::endl;
         
         std::string assistant_reply = ai_core.AI_Image_Prompt(
-            messages_json,
+            request,
             1.0,    // TEMPERATURE
             300,    // MAX_TOKENS
             0.0,    // FREQUENCY_PENALTY
@@ -0,0 +1,185 @@
+// Drives HttpClient against local mock servers: preconnect timeout, once-per-process
+// preconnect, connection reuse across posts and post timeouts. Exits non-zero on failure.
+#include "get_coordinates/http_client.hpp"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using get_coordinates::HttpClient;
+
+namespace {
+
+// HTTP/1.1 keep-alive server on 127.0.0.1 answering every request with "{}",
+// or accepting connections and never answering when stalled
+class MockServer {
+public:
+    explicit MockServer(bool stalled) : stalled(stalled) {
+        listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(address);
+        if (listen_fd < 0 || bind(listen_fd, reinterpret_cast<sockaddr*>(&address), length) != 0 ||
+            listen(listen_fd, 16) != 0 ||
+            getsockname(listen_fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+            throw std::runtime_error("Mock server failed to listen");
+        }
+        port = ntohs(address.sin_port);
+        worker = std::thread([this] { serve(); });
+    }
+
+    ~MockServer() {
+        stopping = true;
+        worker.join();
+        close(listen_fd);
+    }
+
+    std::string url() const { return "http://127.0.0.1:" + std::to_string(port) + "/v1/chat/completions"; }
+
+    std::atomic<int> connections{0};
+    std::atomic<int> requests{0};
+
+private:
+    bool stalled;
+    int listen_fd = -1;
+    int port = 0;
+    std::atomic<bool> stopping{false};
+    std::thread worker;
+
+    void serve() {
+        std::map<int, std::string> clients;
+        while (!stopping) {
+            std::vector<pollfd> fds{{listen_fd, POLLIN, 0}};
+            for (const auto& client : clients) {
+                fds.push_back({client.first, POLLIN, 0});
+            }
+            if (poll(fds.data(), fds.size(), 20) <= 0) {
+                continue;
+            }
+            if (fds[0].revents & POLLIN) {
+                int fd = accept(listen_fd, nullptr, nullptr);
+                if (fd >= 0) {
+                    clients[fd];
+                    connections++;
+                }
+            }
+            for (size_t i = 1; i < fds.size(); ++i) {
+                if (!(fds[i].revents & (POLLIN | POLLHUP))) {
+                    continue;
+                }
+                char buffer[4096];
+                ssize_t received = recv(fds[i].fd, buffer, sizeof(buffer), 0);
+                if (received <= 0) {
+                    close(fds[i].fd);
+                    clients.erase(fds[i].fd);
+                    continue;
+                }
+                std::string& pending = clients[fds[i].fd];
+                pending.append(buffer, static_cast<size_t>(received));
+                answerComplete(fds[i].fd, pending);
+            }
+        }
+        for (const auto& client : clients) {
+            close(client.first);
+        }
+    }
+
+    // Answer every complete request buffered for a connection
+    void answerComplete(int fd, std::string& pending) {
+        while (true) {
+            size_t header_end = pending.find("\r\n\r\n");
+            if (header_end == std::string::npos) {
+                return;
+            }
+            size_t body_length = 0;
+            size_t field = pending.find("Content-Length:");
+            if (field != std::string::npos && field < header_end) {
+                body_length = std::stoul(pending.substr(field + 15));
+            }
+            if (pending.size() < header_end + 4 + body_length) {
+                return;
+            }
+            pending.erase(0, header_end + 4 + body_length);
+            requests++;
+            if (!stalled) {
+                static const std::string reply = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+                                                 "Content-Length: 2\r\n\r\n{}";
+                send(fd, reply.data(), reply.size(), MSG_NOSIGNAL);
+            }
+        }
+    }
+};
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "ok   " : "FAIL ") << what << std::endl;
+    if (!condition) {
+        failures++;
+    }
+}
+
+long elapsedMs(std::chrono::steady_clock::time_point start) {
+    return static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+} // namespace
+
+int main() {
+    HttpClient& client = HttpClient::instance();
+    MockServer stalled(true);
+    MockServer server(false);
+
+    // The first preconnect goes to a server that never answers and must give up on its timeout
+    auto start = std::chrono::steady_clock::now();
+    client.preconnect(stalled.url(), 300);
+    check(elapsedMs(start) < 3000, "preconnect to a stalled server returns after its timeout");
+    check(stalled.requests == 1, "preconnect sent one HEAD request");
+
+    // Preconnect runs once per process
+    client.preconnect(server.url(), 300);
+    check(server.connections == 0 && server.requests == 0, "second preconnect is a no-op");
+
+    curl_slist* headers = curl_slist_append(nullptr, "Content-Type: application/json");
+    std::string body = "{\"model\":\"mock\"}";
+    bool posted = true;
+    for (int i = 0; i < 3; ++i) {
+        try {
+            HttpClient::Response response = client.post(server.url(), headers, body, 2000);
+            posted = posted && response.status == 200 && response.body == "{}";
+        } catch (const std::exception& e) {
+            std::cout << e.what() << std::endl;
+            posted = false;
+        }
+    }
+    check(posted, "posts to the mock server succeed");
+    check(server.requests == 3, "mock server saw 3 requests");
+    check(server.connections == 1, "posts reuse one connection");
+
+    start = std::chrono::steady_clock::now();
+    bool timed_out = false;
+    try {
+        client.post(stalled.url(), headers, body, 300);
+    } catch (const std::runtime_error&) {
+        timed_out = true;
+    }
+    check(timed_out && elapsedMs(start) < 3000, "post to a stalled server times out");
+    curl_slist_free_all(headers);
+
+    HttpClient::Stats stats = client.stats();
+    check(stats.requests == 4 && stats.failures == 1, "stats count requests and failures");
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}